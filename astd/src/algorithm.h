@@ -0,0 +1,575 @@
+#pragma once
+#ifndef ASTD_ALGORITHM
+#define ASTD_ALGORITHM
+#include "type_traits.h"
+#include "functional.h"
+
+/*
+Mirrors parts of <algorithm>. When both ranges are plain pointers to a trivially copyable type the
+algorithms are dispatched at compile time to the mem* functions of the libc, which are hand written
+assembly on AVR:
+
+copy, copy_n, move,  memmove (so overlapping ranges are fine in both directions)
+move_backward
+fill, fill_n         memset for byte sized types
+equal                memcmp for integral, enum and pointer types, whose equality is bitwise
+swap_ranges          memcpy through a small stack buffer
+
+Everything else, and every evaluation in a constant expression, uses the element loops, so the
+algorithms stay constexpr. Compilers without __builtin_is_constant_evaluated (GCC < 9, e.g. the
+GCC 7 of the Arduino AVR core) always take the mem* path for such pointers and thus can not evaluate
+those calls at compile time.
+
+The sorting and searching algorithms need random access iterators and default to less<>:
+
+sort            insertion sort up to 16 elements, above that an introsort (median of three quicksort
+                which falls back to heapsort after 2 * log2(N) levels, so it stays O(N log N))
+static_sort<N>  not part of the STL, a Batcher odd-even merge sorting network for a size known at
+                compile time. The sequence of compare-exchanges only depends on N and not on the
+                data, so the run time is the same for every input, e.g. for a median filter
+partial_sort    heap select followed by a heapsort of the selected elements
+nth_element     introselect, again with a heapsort fallback
+lower_bound, upper_bound, binary_search
+                halving search, also usable on a progmem_array
+make_heap, push_heap, pop_heap, sort_heap, is_heap, is_heap_until
+                binary max heap with respect to comp, like the STL
+*/
+
+namespace astd
+{
+    template<typename FwdIt1, typename FwdIt2>
+    constexpr void iter_swap(FwdIt1 lhs, FwdIt2 rhs)
+    {
+        swap(*lhs, *rhs);
+    }
+
+    // the run time paths, kept out of the constexpr functions since they need uninitialized locals
+    template<typename T>
+    inline void _fill_bytes(T* pDst, T val, size_t count) noexcept
+    {
+        static_assert(sizeof(T) == 1, "_fill_bytes needs a byte sized type");
+        unsigned char byte;
+        memcpy(&byte, &val, 1);
+        memset(pDst, byte, count);
+    }
+
+    inline void _swap_bytes(void* pLhs, void* pRhs, size_t count) noexcept
+    {
+        auto* pLhsByte = static_cast<unsigned char*>(pLhs);
+        auto* pRhsByte = static_cast<unsigned char*>(pRhs);
+        unsigned char buffer[16];
+        while (count > 0)
+        {
+            const auto chunk = count < sizeof(buffer) ? count : sizeof(buffer);
+            memcpy(buffer, pLhsByte, chunk);
+            memcpy(pLhsByte, pRhsByte, chunk);
+            memcpy(pRhsByte, buffer, chunk);
+            pLhsByte += chunk;
+            pRhsByte += chunk;
+            count -= chunk;
+        }
+    }
+
+    // true if [first, last) of type It1 can be handled as raw bytes together with a range of type It2
+    template<typename It1, typename It2>
+    constexpr bool _is_memcpyable_v = is_pointer_v<It1> && is_pointer_v<It2>
+        && is_same_v<remove_cv_t<remove_pointer_t<It1>>, remove_cv_t<remove_pointer_t<It2>>>
+        && is_same_v<remove_volatile_t<remove_pointer_t<It1>>, remove_pointer_t<It1>>
+        && is_same_v<remove_volatile_t<remove_pointer_t<It2>>, remove_pointer_t<It2>>
+        && is_trivially_copyable_v<remove_pointer_t<It1>>;
+
+    template<typename It1, typename It2>
+    constexpr bool _is_memcmpable_v = _is_memcpyable_v<It1, It2>
+        && (is_integral_v<remove_pointer_t<It1>> || is_enum_v<remove_pointer_t<It1>> || is_pointer_v<remove_pointer_t<It1>>);
+
+    template<typename InputIt, typename OutputIt>
+    constexpr OutputIt copy(InputIt first, InputIt last, OutputIt dFirst)
+    {
+        if constexpr (_is_memcpyable_v<InputIt, OutputIt>)
+        {
+            if (!is_constant_evaluated())
+            {
+                const auto count = static_cast<size_t>(last - first);
+                if (count > 0)
+                    memmove(dFirst, first, sizeof(*first) * count);
+                return dFirst + count;
+            }
+        }
+
+        for (; first != last; ++first, ++dFirst)
+            *dFirst = *first;
+        return dFirst;
+    }
+
+    template<typename InputIt, typename Size, typename OutputIt>
+    constexpr OutputIt copy_n(InputIt first, Size count, OutputIt dFirst)
+    {
+        if constexpr (_is_memcpyable_v<InputIt, OutputIt>)
+        {
+            if (!is_constant_evaluated())
+            {
+                if (count <= 0)
+                    return dFirst;
+
+                memmove(dFirst, first, sizeof(*first) * static_cast<size_t>(count));
+                return dFirst + count;
+            }
+        }
+
+        for (; count > 0; --count, ++first, ++dFirst)
+            *dFirst = *first;
+        return dFirst;
+    }
+
+    template<typename InputIt, typename OutputIt>
+    constexpr OutputIt move(InputIt first, InputIt last, OutputIt dFirst)
+    {
+        if constexpr (_is_memcpyable_v<InputIt, OutputIt>)
+        {
+            if (!is_constant_evaluated())
+            {
+                const auto count = static_cast<size_t>(last - first);
+                if (count > 0)
+                    memmove(dFirst, first, sizeof(*first) * count);
+                return dFirst + count;
+            }
+        }
+
+        for (; first != last; ++first, ++dFirst)
+            *dFirst = astd::move(*first);
+        return dFirst;
+    }
+
+    template<typename BidirIt1, typename BidirIt2>
+    constexpr BidirIt2 move_backward(BidirIt1 first, BidirIt1 last, BidirIt2 dLast)
+    {
+        if constexpr (_is_memcpyable_v<BidirIt1, BidirIt2>)
+        {
+            if (!is_constant_evaluated())
+            {
+                const auto count = static_cast<size_t>(last - first);
+                if (count > 0)
+                    memmove(dLast - count, first, sizeof(*first) * count);
+                return dLast - count;
+            }
+        }
+
+        while (first != last)
+            *(--dLast) = astd::move(*(--last));
+        return dLast;
+    }
+
+    template<typename OutputIt, typename Size, typename T>
+    constexpr OutputIt fill_n(OutputIt first, Size count, const T& val)
+    {
+        if constexpr (is_pointer_v<OutputIt>)
+        {
+            using value_type = remove_pointer_t<OutputIt>;
+            if constexpr (sizeof(value_type) == 1 && is_trivially_copyable_v<value_type>
+                && is_same_v<remove_volatile_t<value_type>, value_type>)
+            {
+                if (!is_constant_evaluated())
+                {
+                    if (count <= 0)
+                        return first;
+
+                    _fill_bytes(first, static_cast<value_type>(val), static_cast<size_t>(count));
+                    return first + count;
+                }
+            }
+        }
+
+        for (; count > 0; --count, ++first)
+            *first = val;
+        return first;
+    }
+
+    template<typename FwdIt, typename T>
+    constexpr void fill(FwdIt first, FwdIt last, const T& val)
+    {
+        if constexpr (is_pointer_v<FwdIt>)
+            fill_n(first, last - first, val);
+        else
+            for (; first != last; ++first)
+                *first = val;
+    }
+
+    template<typename InputIt1, typename InputIt2>
+    [[nodiscard]] constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2)
+    {
+        if constexpr (_is_memcmpable_v<InputIt1, InputIt2>)
+        {
+            if (!is_constant_evaluated())
+                return first1 == last1 || memcmp(first1, first2, sizeof(*first1) * static_cast<size_t>(last1 - first1)) == 0;
+        }
+
+        for (; first1 != last1; ++first1, ++first2)
+            if (!(*first1 == *first2))
+                return false;
+
+        return true;
+    }
+
+    template<typename InputIt1, typename InputIt2>
+    [[nodiscard]] constexpr bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2)
+    {
+        if constexpr (is_pointer_v<InputIt1> && is_pointer_v<InputIt2>)
+        {
+            if (last1 - first1 != last2 - first2)
+                return false;
+
+            return equal(first1, last1, first2);
+        }
+        else
+        {
+            for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+                if (!(*first1 == *first2))
+                    return false;
+
+            return first1 == last1 && first2 == last2;
+        }
+    }
+
+    template<typename FwdIt1, typename FwdIt2>
+    constexpr FwdIt2 swap_ranges(FwdIt1 first1, FwdIt1 last1, FwdIt2 first2)
+    {
+        if constexpr (_is_memcpyable_v<FwdIt1, FwdIt2> && !is_const_v<remove_pointer_t<FwdIt1>>
+            && !is_const_v<remove_pointer_t<FwdIt2>>)
+        {
+            if (!is_constant_evaluated())
+            {
+                _swap_bytes(first1, first2, sizeof(*first1) * static_cast<size_t>(last1 - first1));
+                return first2 + (last1 - first1);
+            }
+        }
+
+        for (; first1 != last1; ++first1, ++first2)
+            astd::iter_swap(first1, first2);
+        return first2;
+    }
+
+    // sorting networks and sorts of small ranges are faster than the introsort below this size
+    constexpr ptrdiff_t _sort_threshold = 16;
+    constexpr size_t _sort_network_max = 32;
+
+    template<typename T, typename Compare>
+    constexpr void _compare_exchange(T& lhs, T& rhs, Compare& comp)
+    {
+        // selects instead of a conditional swap, which compile to conditional moves where available
+        const bool isSwapped = comp(rhs, lhs);
+        auto low = astd::move(isSwapped ? rhs : lhs);
+        auto high = astd::move(isSwapped ? lhs : rhs);
+        lhs = astd::move(low);
+        rhs = astd::move(high);
+    }
+
+    template<typename RandomIt, typename Compare>
+    constexpr void _insertion_sort(RandomIt first, RandomIt last, Compare& comp)
+    {
+        if (first == last)
+            return;
+
+        for (auto it = first + 1; it != last; ++it)
+        {
+            auto val = astd::move(*it);
+            auto hole = it;
+            for (; hole != first && comp(val, *(hole - 1)); --hole)
+                *hole = astd::move(*(hole - 1));
+            *hole = astd::move(val);
+        }
+    }
+
+    // restores the max heap property of [first, first + len) below idx
+    template<typename RandomIt, typename Compare>
+    constexpr void _sift_down(RandomIt first, ptrdiff_t idx, ptrdiff_t len, Compare& comp)
+    {
+        auto val = astd::move(first[idx]);
+        for (auto child = 2 * idx + 1; child < len; child = 2 * idx + 1)
+        {
+            if (child + 1 < len && comp(first[child], first[child + 1]))
+                ++child;
+            if (!comp(val, first[child]))
+                break;
+
+            first[idx] = astd::move(first[child]);
+            idx = child;
+        }
+        first[idx] = astd::move(val);
+    }
+
+    template<typename RandomIt, typename Compare>
+    constexpr void _sift_up(RandomIt first, ptrdiff_t idx, Compare& comp)
+    {
+        auto val = astd::move(first[idx]);
+        while (idx > 0)
+        {
+            const auto parent = (idx - 1) / 2;
+            if (!comp(first[parent], val))
+                break;
+
+            first[idx] = astd::move(first[parent]);
+            idx = parent;
+        }
+        first[idx] = astd::move(val);
+    }
+
+    template<typename RandomIt, typename Compare>
+    constexpr void _make_heap_impl(RandomIt first, ptrdiff_t len, Compare& comp)
+    {
+        for (auto idx = len / 2; idx > 0; --idx)
+            _sift_down(first, idx - 1, len, comp);
+    }
+
+    template<typename RandomIt, typename Compare>
+    constexpr void _sort_heap_impl(RandomIt first, ptrdiff_t len, Compare& comp)
+    {
+        for (; len > 1; --len)
+        {
+            astd::iter_swap(first, first + (len - 1));
+            _sift_down(first, 0, len - 1, comp);
+        }
+    }
+
+    // moves the smallest middle - first elements to the front and sorts them
+    template<typename RandomIt, typename Compare>
+    constexpr void _partial_sort_impl(RandomIt first, RandomIt middle, RandomIt last, Compare& comp)
+    {
+        const auto len = middle - first;
+        if (len == 0)
+            return;
+
+        _make_heap_impl(first, len, comp);
+        for (auto it = middle; it != last; ++it)
+        {
+            if (comp(*it, *first))
+            {
+                astd::iter_swap(it, first);
+                _sift_down(first, 0, len, comp);
+            }
+        }
+        _sort_heap_impl(first, len, comp);
+    }
+
+    template<typename RandomIt, typename Compare>
+    constexpr void _move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare& comp)
+    {
+        if (comp(*a, *b))
+        {
+            if (comp(*b, *c))
+                astd::iter_swap(result, b);
+            else if (comp(*a, *c))
+                astd::iter_swap(result, c);
+            else
+                astd::iter_swap(result, a);
+        }
+        else if (comp(*a, *c))
+            astd::iter_swap(result, a);
+        else if (comp(*b, *c))
+            astd::iter_swap(result, c);
+        else
+            astd::iter_swap(result, b);
+    }
+
+    // partitions around the median of three, which also serves as sentinel for the inner loops
+    template<typename RandomIt, typename Compare>
+    constexpr RandomIt _partition_pivot(RandomIt first, RandomIt last, Compare& comp)
+    {
+        _move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+
+        auto low = first + 1;
+        auto high = last;
+        while (true)
+        {
+            while (comp(*low, *first))
+                ++low;
+            --high;
+            while (comp(*first, *high))
+                --high;
+            if (!(low < high))
+                return low;
+
+            astd::iter_swap(low, high);
+            ++low;
+        }
+    }
+
+    [[nodiscard]] constexpr int _introsort_depth(ptrdiff_t len) noexcept
+    {
+        int depth = 0;
+        for (; len > 1; len >>= 1)
+            depth += 2;
+        return depth;
+    }
+
+    template<typename RandomIt, typename Compare>
+    constexpr void _introsort_loop(RandomIt first, RandomIt last, int depth, Compare& comp)
+    {
+        while (last - first > _sort_threshold)
+        {
+            if (depth == 0)
+            {
+                _partial_sort_impl(first, last, last, comp);
+                return;
+            }
+
+            --depth;
+            const auto cut = _partition_pivot(first, last, comp);
+            // recurse into the smaller part, so the stack depth stays logarithmic
+            if (cut - first < last - cut)
+            {
+                _introsort_loop(first, cut, depth, comp);
+                first = cut;
+            }
+            else
+            {
+                _introsort_loop(cut, last, depth, comp);
+                last = cut;
+            }
+        }
+        _insertion_sort(first, last, comp);
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void sort(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        _introsort_loop(first, last, _introsort_depth(last - first), comp);
+    }
+
+    template<size_t _size, typename RandomIt, typename Compare = less<>>
+    constexpr void static_sort(RandomIt first, Compare comp = Compare())
+    {
+        // Batcher's odd-even merge sort, the conditions only depend on the indices
+        for (size_t p = 1; p < _size; p <<= 1)
+            for (size_t k = p; k >= 1; k >>= 1)
+                for (size_t j = k % p; j + k < _size; j += 2 * k)
+                    for (size_t i = 0; i < k && i + j + k < _size; ++i)
+                        if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+                            _compare_exchange(first[i + j], first[i + j + k], comp);
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void make_heap(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        _make_heap_impl(first, last - first, comp);
+    }
+
+    // [first, last - 1) has to be a heap, the element at last - 1 is added to it
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void push_heap(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        if (last - first > 1)
+            _sift_up(first, last - first - 1, comp);
+    }
+
+    // moves the first, largest element to last - 1 and makes [first, last - 1) a heap again
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void pop_heap(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        const auto len = last - first;
+        if (len > 1)
+        {
+            astd::iter_swap(first, last - 1);
+            _sift_down(first, 0, len - 1, comp);
+        }
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void sort_heap(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        _sort_heap_impl(first, last - first, comp);
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    [[nodiscard]] constexpr RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        const auto len = last - first;
+        for (ptrdiff_t idx = 1; idx < len; ++idx)
+            if (comp(first[(idx - 1) / 2], first[idx]))
+                return first + idx;
+
+        return last;
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    [[nodiscard]] constexpr bool is_heap(RandomIt first, RandomIt last, Compare comp = Compare())
+    {
+        return astd::is_heap_until(first, last, comp) == last;
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare())
+    {
+        _partial_sort_impl(first, middle, last, comp);
+    }
+
+    template<typename RandomIt, typename Compare = less<>>
+    constexpr void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare())
+    {
+        if (nth == last)
+            return;
+
+        auto depth = _introsort_depth(last - first);
+        while (last - first > _sort_threshold)
+        {
+            if (depth == 0)
+            {
+                _partial_sort_impl(first, nth + 1, last, comp);
+                return;
+            }
+
+            --depth;
+            const auto cut = _partition_pivot(first, last, comp);
+            if (cut <= nth)
+                first = cut;
+            else
+                last = cut;
+        }
+        _insertion_sort(first, last, comp);
+    }
+
+    template<typename RandomIt, typename T, typename Compare = less<>>
+    [[nodiscard]] constexpr RandomIt lower_bound(RandomIt first, RandomIt last, const T& val, Compare comp = Compare())
+    {
+        auto count = last - first;
+        while (count > 0)
+        {
+            const auto step = count / 2;
+            const auto it = first + step;
+            if (comp(*it, val))
+            {
+                first = it + 1;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+        return first;
+    }
+
+    template<typename RandomIt, typename T, typename Compare = less<>>
+    [[nodiscard]] constexpr RandomIt upper_bound(RandomIt first, RandomIt last, const T& val, Compare comp = Compare())
+    {
+        auto count = last - first;
+        while (count > 0)
+        {
+            const auto step = count / 2;
+            const auto it = first + step;
+            if (!comp(val, *it))
+            {
+                first = it + 1;
+                count -= step + 1;
+            }
+            else
+                count = step;
+        }
+        return first;
+    }
+
+    template<typename RandomIt, typename T, typename Compare = less<>>
+    [[nodiscard]] constexpr bool binary_search(RandomIt first, RandomIt last, const T& val, Compare comp = Compare())
+    {
+        first = astd::lower_bound(first, last, val, comp);
+        return first != last && !comp(val, *first);
+    }
+}
+#endif // ASTD_ALGORITHM
\ No newline at end of file
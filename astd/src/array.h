@@ -2,6 +2,8 @@
 #ifndef ASTD_ARRAY
 #define ASTD_ARRAY
 #include "error.h"
+#include "utility.h"
+#include "algorithm.h"
 
 namespace astd
 {
@@ -25,12 +27,9 @@ namespace astd
         using const_iterator = const_pointer;
 
 
-        void fill(const T& val) // TODO can this be done at compile time?
+        constexpr void fill(const T& val)
         {
-            // TODO pointer arithmetic? implement std::fill_n?
-            // memset for byte-size types?
-            for (size_t dataIdx = 0; dataIdx < _size; ++dataIdx)
-                m_data[dataIdx] = val;
+            fill_n(m_data, _size, val);
         }
 
         [[nodiscard]] inline T& at(size_t idx)
@@ -166,5 +165,63 @@ namespace astd
         static_assert(idx < _size, "array index out of bounds");
         return move(arr.m_data[idx]);
     }
+
+    template<typename T, size_t _size, size_t... idx>
+    constexpr array<remove_cv_t<T>, _size> _to_array_impl(T(&arr)[_size], index_sequence<idx...>)
+    {
+        return { { arr[idx]... } };
+    }
+
+    template<typename T, size_t _size, size_t... idx>
+    constexpr array<remove_cv_t<T>, _size> _to_array_impl(T(&&arr)[_size], index_sequence<idx...>)
+    {
+        return { { move(arr[idx])... } };
+    }
+
+    // array from a C array or a braced list, e.g. to_array({ 1, 2, 3 }) deduces array<int, 3>
+    template<typename T, size_t _size>
+    [[nodiscard]] constexpr array<remove_cv_t<T>, _size> to_array(T(&arr)[_size])
+    {
+        return _to_array_impl(arr, make_index_sequence<_size>());
+    }
+
+    template<typename T, size_t _size>
+    [[nodiscard]] constexpr array<remove_cv_t<T>, _size> to_array(T(&&arr)[_size])
+    {
+        return _to_array_impl(move(arr), make_index_sequence<_size>());
+    }
+
+    template<typename Func, size_t... idx>
+    constexpr auto _generate_array_impl(Func& func, index_sequence<idx...>)
+    {
+        return array<remove_cv_t<decltype(func(size_t()))>, sizeof...(idx)>{ { func(idx)... } };
+    }
+
+    // not part of the STL, element idx is func(idx). With a constexpr func the table is computed by the
+    // compiler, e.g. constexpr auto squares = generate_array<16>([](size_t idx) { return idx * idx; });
+    template<size_t _size, typename Func>
+    [[nodiscard]] constexpr auto generate_array(Func func)
+    {
+        return _generate_array_impl(func, make_index_sequence<_size>());
+    }
+
+    // up to 32 elements a sorting network, whose run time does not depend on the values
+    template<typename T, size_t _size, typename Compare = less<>>
+    constexpr void sort(array<T, _size>& arr, Compare comp = Compare())
+    {
+        if constexpr (_size <= _sort_network_max)
+            static_sort<_size>(arr.m_data, comp);
+        else
+            sort(arr.m_data, arr.m_data + _size, comp);
+    }
+
+    // median of a window, e.g. of the last N sensor readings, the window itself is left unchanged
+    template<typename T, size_t _size, typename Compare = less<>>
+    [[nodiscard]] constexpr T median(array<T, _size> window, Compare comp = Compare())
+    {
+        static_assert(_size > 0, "median of an empty array");
+        sort(window, comp);
+        return astd::move(window.m_data[_size / 2]);
+    }
 }
 #endif //ASTD_ARRAY
\ No newline at end of file
@@ -0,0 +1,229 @@
+#pragma once
+#ifndef ASTD_BIT
+#define ASTD_BIT
+
+/*
+Mirrors the C++20 header <bit> for unsigned integer types. The functions are constexpr templates with
+one implementation per target:
+
+On hosts they map onto the compiler builtins, which become single instructions.
+On AVR the builtins are out of line libgcc routines that loop over every bit of a 32 bit value, so the
+functions work byte by byte instead. popcount folds each byte with the shift and mask trick, where the
+nibble step compiles to a single swap instruction. The zero counts skip whole zero bytes first, which
+are plain register moves on an 8 bit core, and binary search the remaining byte.
+
+bit_cast is constexpr only if the compiler offers __builtin_bit_cast (GCC 11, clang 9), otherwise it
+falls back to memcpy.
+*/
+
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_bit_cast)
+#define ASTD_CONSTEXPR_BIT_CAST 1
+#endif
+#endif
+
+namespace astd
+{
+    enum class endian
+    {
+        little = __ORDER_LITTLE_ENDIAN__,
+        big = __ORDER_BIG_ENDIAN__,
+        native = __BYTE_ORDER__
+    };
+
+    template<typename T>
+    struct _bit_digits
+    {
+        static_assert(static_cast<T>(-1) > static_cast<T>(0), "bit operations need an unsigned integer type");
+        static constexpr int value = static_cast<int>(8 * sizeof(T));
+    };
+
+#ifdef __AVR__
+    [[nodiscard]] constexpr uint8_t _popcount8(uint8_t val) noexcept
+    {
+        val = static_cast<uint8_t>(val - ((val >> 1) & 0x55));
+        val = static_cast<uint8_t>((val & 0x33) + ((val >> 2) & 0x33));
+        return static_cast<uint8_t>((val + (val >> 4)) & 0x0F);
+    }
+
+    // undefined for val == 0
+    [[nodiscard]] constexpr int _countr_zero8(uint8_t val) noexcept
+    {
+        int result = 0;
+        if ((val & 0x0F) == 0)
+        {
+            result += 4;
+            val >>= 4;
+        }
+        if ((val & 0x03) == 0)
+        {
+            result += 2;
+            val >>= 2;
+        }
+        return result + ((val & 0x01) == 0 ? 1 : 0);
+    }
+
+    // undefined for val == 0
+    [[nodiscard]] constexpr int _countl_zero8(uint8_t val) noexcept
+    {
+        int result = 0;
+        if ((val & 0xF0) == 0)
+        {
+            result += 4;
+            val = static_cast<uint8_t>(val << 4);
+        }
+        if ((val & 0xC0) == 0)
+        {
+            result += 2;
+            val = static_cast<uint8_t>(val << 2);
+        }
+        return result + ((val & 0x80) == 0 ? 1 : 0);
+    }
+#endif // __AVR__
+
+    template<typename T>
+    [[nodiscard]] constexpr int popcount(T val) noexcept
+    {
+        [[maybe_unused]] constexpr auto digits = _bit_digits<T>::value;
+#ifdef __AVR__
+        int result = 0;
+        for (int byteIdx = 0; byteIdx < digits / 8; ++byteIdx)
+        {
+            result += _popcount8(static_cast<uint8_t>(val));
+            val = static_cast<T>(val >> 8);
+        }
+        return result;
+#else
+        if constexpr (sizeof(T) <= sizeof(unsigned int))
+            return __builtin_popcount(val);
+        else if constexpr (sizeof(T) <= sizeof(unsigned long))
+            return __builtin_popcountl(val);
+        else
+            return __builtin_popcountll(val);
+#endif // __AVR__
+    }
+
+    // number of consecutive zero bits starting at the lsb
+    template<typename T>
+    [[nodiscard]] constexpr int countr_zero(T val) noexcept
+    {
+        constexpr auto digits = _bit_digits<T>::value;
+        if (val == 0)
+            return digits;
+
+#ifdef __AVR__
+        int result = 0;
+        while (static_cast<uint8_t>(val) == 0)
+        {
+            result += 8;
+            val = static_cast<T>(val >> 8);
+        }
+        return result + _countr_zero8(static_cast<uint8_t>(val));
+#else
+        if constexpr (sizeof(T) <= sizeof(unsigned int))
+            return __builtin_ctz(val);
+        else if constexpr (sizeof(T) <= sizeof(unsigned long))
+            return __builtin_ctzl(val);
+        else
+            return __builtin_ctzll(val);
+#endif // __AVR__
+    }
+
+    // number of consecutive zero bits starting at the msb
+    template<typename T>
+    [[nodiscard]] constexpr int countl_zero(T val) noexcept
+    {
+        constexpr auto digits = _bit_digits<T>::value;
+        if (val == 0)
+            return digits;
+
+#ifdef __AVR__
+        int result = 0;
+        while (static_cast<uint8_t>(val >> (digits - 8)) == 0)
+        {
+            result += 8;
+            val = static_cast<T>(val << 8);
+        }
+        return result + _countl_zero8(static_cast<uint8_t>(val >> (digits - 8)));
+#else
+        if constexpr (sizeof(T) <= sizeof(unsigned int))
+            return __builtin_clz(val) - (static_cast<int>(8 * sizeof(unsigned int)) - digits);
+        else if constexpr (sizeof(T) <= sizeof(unsigned long))
+            return __builtin_clzl(val) - (static_cast<int>(8 * sizeof(unsigned long)) - digits);
+        else
+            return __builtin_clzll(val) - (static_cast<int>(8 * sizeof(unsigned long long)) - digits);
+#endif // __AVR__
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr int countr_one(T val) noexcept
+    {
+        return countr_zero(static_cast<T>(~val));
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr int countl_one(T val) noexcept
+    {
+        return countl_zero(static_cast<T>(~val));
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr T rotr(T val, int shift) noexcept;
+
+    template<typename T>
+    [[nodiscard]] constexpr T rotl(T val, int shift) noexcept
+    {
+        constexpr auto digits = _bit_digits<T>::value;
+        const auto rem = shift % digits;
+        if (rem == 0)
+            return val;
+        else if (rem < 0)
+            return rotr(val, -rem);
+
+        return static_cast<T>(static_cast<T>(val << rem) | static_cast<T>(val >> (digits - rem)));
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr T rotr(T val, int shift) noexcept
+    {
+        constexpr auto digits = _bit_digits<T>::value;
+        const auto rem = shift % digits;
+        if (rem == 0)
+            return val;
+        else if (rem < 0)
+            return rotl(val, -rem);
+
+        return static_cast<T>(static_cast<T>(val >> rem) | static_cast<T>(val << (digits - rem)));
+    }
+
+    template<typename T>
+    [[nodiscard]] constexpr bool has_single_bit(T val) noexcept
+    {
+        return val != 0 && (val & static_cast<T>(val - 1)) == 0;
+    }
+
+    // number of bits needed to represent val, 0 for val == 0
+    template<typename T>
+    [[nodiscard]] constexpr int bit_width(T val) noexcept
+    {
+        return _bit_digits<T>::value - countl_zero(val);
+    }
+
+    template<typename To, typename From>
+#ifdef ASTD_CONSTEXPR_BIT_CAST
+    [[nodiscard]] constexpr To bit_cast(const From& src) noexcept
+    {
+        static_assert(sizeof(To) == sizeof(From), "bit_cast needs types of equal size");
+        return __builtin_bit_cast(To, src);
+    }
+#else
+    [[nodiscard]] inline To bit_cast(const From& src) noexcept
+    {
+        static_assert(sizeof(To) == sizeof(From), "bit_cast needs types of equal size");
+        To dst;
+        memcpy(&dst, &src, sizeof(To));
+        return dst;
+    }
+#endif // ASTD_CONSTEXPR_BIT_CAST
+}
+#endif // ASTD_BIT
\ No newline at end of file
@@ -0,0 +1,361 @@
+#pragma once
+#ifndef ASTD_BIT_MATRIX
+#define ASTD_BIT_MATRIX
+#include "bitset.h"
+#include "type_traits.h"
+#include "error.h"
+
+/*
+bit_matrix is not part of the STL. It is meant as a frame buffer for LED matrices and monochrome
+displays. Every row is a bitset<_cols>, so row operations like |=, <<= or count() are word wide and
+the rows are stored back to back. Column c of a row is bit c % 8 of byte c / 8 of the row, so
+row_data() can be handed to SPI or DMA directly. A row occupies row_stride bytes of which the first
+row_bytes are meaningful.
+
+Blocks of 8x8 bits (with the column a multiple of 8) can be read, written and transposed as a whole,
+which also backs transpose() for matrices whose dimensions are multiples of 8.
+*/
+
+namespace astd
+{
+    static_assert(endian::native == endian::little, "bit_matrix assumes a little endian word layout");
+
+    // transposes the 8x8 bit block with bit (row, col) at position 8 * row + col
+    [[nodiscard]] constexpr uint64_t _transpose8(uint64_t block) noexcept
+    {
+        auto tmp = (block ^ (block >> 7)) & 0x00AA00AA00AA00AAULL;
+        block ^= tmp ^ (tmp << 7);
+        tmp = (block ^ (block >> 14)) & 0x0000CCCC0000CCCCULL;
+        block ^= tmp ^ (tmp << 14);
+        tmp = (block ^ (block >> 28)) & 0x00000000F0F0F0F0ULL;
+        block ^= tmp ^ (tmp << 28);
+        return block;
+    }
+
+    template<size_t _rows, size_t _cols>
+    class bit_matrix
+    {
+        static_assert(_rows > 0 && _cols > 0, "bit_matrix needs at least one row and column");
+
+    private:
+        using word_type = _bitset_access::word_type<_cols>;
+
+    public:
+        using row_type = bitset<_cols>;
+
+        static constexpr size_t row_bytes = (_cols + 7) / 8;
+        static constexpr size_t row_stride = sizeof(row_type);
+
+        constexpr bit_matrix() noexcept
+            :m_rows{}
+        {}
+
+        [[nodiscard]] bool operator==(const bit_matrix& other) const noexcept
+        {
+            for (size_t row = 0; row < _rows; ++row)
+                if (!(m_rows[row] == other.m_rows[row]))
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] bool operator!=(const bit_matrix& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] row_type& operator[](size_t row) noexcept
+        {
+#if _DEBUG
+            verify(row < _rows, "bit_matrix subscription out of range");
+#endif
+            return m_rows[row];
+        }
+
+        [[nodiscard]] const row_type& operator[](size_t row) const noexcept
+        {
+#if _DEBUG
+            verify(row < _rows, "bit_matrix subscription out of range");
+#endif
+            return m_rows[row];
+        }
+
+        [[nodiscard]] row_type& row(size_t row)
+        {
+            verify(row < _rows, "invalid bit_matrix row");
+            return m_rows[row];
+        }
+
+        [[nodiscard]] const row_type& row(size_t row) const
+        {
+            verify(row < _rows, "invalid bit_matrix row");
+            return m_rows[row];
+        }
+
+        [[nodiscard]] bool test(size_t row, size_t col) const
+        {
+            verify(row < _rows && col < _cols, "invalid bit_matrix index");
+            return m_rows[row][col];
+        }
+
+        bit_matrix& set(size_t row, size_t col, bool value = true)
+        {
+            verify(row < _rows && col < _cols, "invalid bit_matrix index");
+            m_rows[row][col] = value;
+            return *this;
+        }
+
+        bit_matrix& reset(size_t row, size_t col)
+        {
+            return set(row, col, false);
+        }
+
+        bit_matrix& flip(size_t row, size_t col)
+        {
+            verify(row < _rows && col < _cols, "invalid bit_matrix index");
+            m_rows[row].flip(col);
+            return *this;
+        }
+
+        bit_matrix& set() noexcept
+        {
+            for (auto& row : m_rows)
+                row.set();
+            return *this;
+        }
+
+        bit_matrix& reset() noexcept
+        {
+            for (auto& row : m_rows)
+                row.reset();
+            return *this;
+        }
+
+        bit_matrix& operator&=(const bit_matrix& other) noexcept
+        {
+            for (size_t row = 0; row < _rows; ++row)
+                m_rows[row] &= other.m_rows[row];
+            return *this;
+        }
+
+        bit_matrix& operator|=(const bit_matrix& other) noexcept
+        {
+            for (size_t row = 0; row < _rows; ++row)
+                m_rows[row] |= other.m_rows[row];
+            return *this;
+        }
+
+        bit_matrix& operator^=(const bit_matrix& other) noexcept
+        {
+            for (size_t row = 0; row < _rows; ++row)
+                m_rows[row] ^= other.m_rows[row];
+            return *this;
+        }
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            for (const auto& row : m_rows)
+                if (row.any())
+                    return true;
+
+            return false;
+        }
+
+        [[nodiscard]] size_t count() const noexcept
+        {
+            size_t result = 0;
+            for (const auto& row : m_rows)
+                result += row.count();
+            return result;
+        }
+
+        [[nodiscard]] bitset<_rows> column(size_t col) const
+        {
+            verify(col < _cols, "invalid bit_matrix column");
+            bitset<_rows> ret;
+            for (size_t row = 0; row < _rows; ++row)
+                if (m_rows[row][col])
+                    ret.set(row);
+            return ret;
+        }
+
+        bit_matrix& set_column(size_t col, const bitset<_rows>& bits)
+        {
+            verify(col < _cols, "invalid bit_matrix column");
+            for (size_t row = 0; row < _rows; ++row)
+                m_rows[row][col] = bits[row];
+            return *this;
+        }
+
+        // sets or clears the rectangle of height x width bits starting at (row, col)
+        bit_matrix& fill_rect(size_t row, size_t col, size_t height, size_t width, bool value = true)
+        {
+            verify(row <= _rows && height <= _rows - row && col <= _cols && width <= _cols - col, "bit_matrix rectangle out of range");
+
+            for (const auto end = row + height; row < end; ++row)
+            {
+                auto* pWords = _bitset_access::words(m_rows[row]);
+                for (size_t idx = col; idx < col + width;)
+                {
+                    const auto chunk = chunk_size(idx, col + width);
+                    const auto mask = static_cast<word_type>(low_mask(chunk) << idx % s_bitsInWord);
+                    if (value)
+                        pWords[idx / s_bitsInWord] |= mask;
+                    else
+                        pWords[idx / s_bitsInWord] &= ~mask;
+                    idx += chunk;
+                }
+            }
+            return *this;
+        }
+
+        // copies the height x width rectangle at (srcRow, srcCol) of src to (dstRow, dstCol), src may be *this
+        template<size_t _srcRows, size_t _srcCols>
+        bit_matrix& copy_rect(const bit_matrix<_srcRows, _srcCols>& src, size_t srcRow, size_t srcCol,
+            size_t height, size_t width, size_t dstRow, size_t dstCol)
+        {
+            verify(srcRow <= _srcRows && height <= _srcRows - srcRow && srcCol <= _srcCols && width <= _srcCols - srcCol,
+                "bit_matrix source rectangle out of range");
+            verify(dstRow <= _rows && height <= _rows - dstRow && dstCol <= _cols && width <= _cols - dstCol,
+                "bit_matrix destination rectangle out of range");
+
+            // walk the rows backwards if they could overlap, so no source row is overwritten before it is read
+            const bool backwards = static_cast<const void*>(&src) == static_cast<const void*>(this) && dstRow > srcRow;
+            for (size_t rowIdx = 0; rowIdx < height; ++rowIdx)
+            {
+                const auto offset = backwards ? height - 1 - rowIdx : rowIdx;
+                copy_row_range(_bitset_access::words(src[srcRow + offset]), srcCol,
+                    _bitset_access::words(m_rows[dstRow + offset]), dstCol, width);
+            }
+            return *this;
+        }
+
+        // the 8x8 block at (row, col) with bit (r, c) of the block at position 8 * r + c, col has to be a multiple of 8
+        [[nodiscard]] uint64_t block8(size_t row, size_t col) const
+        {
+            verify_block8(row, col);
+            uint64_t block = 0;
+            for (size_t rowIdx = 0; rowIdx < 8; ++rowIdx)
+                block |= static_cast<uint64_t>(row_data(row + rowIdx)[col / 8]) << (8 * rowIdx);
+            return block;
+        }
+
+        bit_matrix& set_block8(size_t row, size_t col, uint64_t block)
+        {
+            verify_block8(row, col);
+            for (size_t rowIdx = 0; rowIdx < 8; ++rowIdx)
+                row_data(row + rowIdx)[col / 8] = static_cast<uint8_t>(block >> (8 * rowIdx));
+            return *this;
+        }
+
+        // transposes the 8x8 block at (row, col) in place
+        bit_matrix& transpose_block8(size_t row, size_t col)
+        {
+            return set_block8(row, col, _transpose8(block8(row, col)));
+        }
+
+        // raw bytes of a row, column c is bit c % 8 of byte c / 8
+        [[nodiscard]] uint8_t* row_data(size_t row) noexcept
+        {
+            return reinterpret_cast<uint8_t*>(_bitset_access::words(m_rows[row]));
+        }
+
+        [[nodiscard]] const uint8_t* row_data(size_t row) const noexcept
+        {
+            return reinterpret_cast<const uint8_t*>(_bitset_access::words(m_rows[row]));
+        }
+
+        // all rows, row_stride bytes apart
+        [[nodiscard]] const uint8_t* data() const noexcept
+        {
+            return row_data(0);
+        }
+
+        [[nodiscard]] constexpr size_t rows() const noexcept
+        {
+            return _rows;
+        }
+
+        [[nodiscard]] constexpr size_t cols() const noexcept
+        {
+            return _cols;
+        }
+
+    private:
+        template<typename SrcWord>
+        static void copy_row_range(const SrcWord* pSrc, size_t srcCol, word_type* pDst, size_t dstCol, size_t width) noexcept
+        {
+            // buffer the source bits first, src and dst may be the same row
+            word_type buffer[s_arrSize];
+            for (size_t idx = 0; idx < width; idx += s_bitsInWord)
+                buffer[idx / s_bitsInWord] = extract_bits(pSrc, srcCol + idx, width - idx < s_bitsInWord ? width - idx : s_bitsInWord);
+
+            for (size_t idx = 0; idx < width;)
+            {
+                const auto dstIdx = dstCol + idx;
+                const auto chunk = chunk_size(dstIdx, dstCol + width);
+                const auto bits = static_cast<word_type>(extract_bits(buffer, idx, chunk) << dstIdx % s_bitsInWord);
+                const auto mask = static_cast<word_type>(low_mask(chunk) << dstIdx % s_bitsInWord);
+                pDst[dstIdx / s_bitsInWord] = (pDst[dstIdx / s_bitsInWord] & ~mask) | bits;
+                idx += chunk;
+            }
+        }
+
+        // count <= bits of word_type bits starting at bit pos
+        template<typename SrcWord>
+        static word_type extract_bits(const SrcWord* pWords, size_t pos, size_t count) noexcept
+        {
+            constexpr size_t bitsInSrcWord = 8 * sizeof(SrcWord);
+            static_assert(bitsInSrcWord == s_bitsInWord, "bit_matrix rows have to share the word type");
+
+            const auto offset = pos % bitsInSrcWord;
+            auto ret = static_cast<word_type>(pWords[pos / bitsInSrcWord] >> offset);
+            if (offset != 0 && offset + count > bitsInSrcWord)
+                ret |= static_cast<word_type>(pWords[pos / bitsInSrcWord + 1] << (bitsInSrcWord - offset));
+            return ret & low_mask(count);
+        }
+
+        // bits from idx up to end or the next word boundary
+        static constexpr size_t chunk_size(size_t idx, size_t end) noexcept
+        {
+            const auto toBoundary = s_bitsInWord - idx % s_bitsInWord;
+            return end - idx < toBoundary ? end - idx : toBoundary;
+        }
+
+        static constexpr word_type low_mask(size_t count) noexcept
+        {
+            return count >= s_bitsInWord ? static_cast<word_type>(~static_cast<word_type>(0))
+                : static_cast<word_type>((static_cast<word_type>(1) << count) - 1);
+        }
+
+        void verify_block8(size_t row, size_t col) const
+        {
+            verify(row + 8 <= _rows && col + 8 <= _cols && col % 8 == 0, "invalid bit_matrix block");
+        }
+
+        static constexpr size_t s_bitsInWord = 8 * sizeof(word_type);
+        static constexpr size_t s_arrSize = _bitset_access::word_count<_cols>;
+
+        row_type m_rows[_rows];
+    };
+
+    template<size_t _rows, size_t _cols>
+    [[nodiscard]] bit_matrix<_cols, _rows> transpose(const bit_matrix<_rows, _cols>& src) noexcept
+    {
+        bit_matrix<_cols, _rows> ret;
+        if constexpr (_rows % 8 == 0 && _cols % 8 == 0)
+        {
+            for (size_t row = 0; row < _rows; row += 8)
+                for (size_t col = 0; col < _cols; col += 8)
+                    ret.set_block8(col, row, _transpose8(src.block8(row, col)));
+        }
+        else
+        {
+            for (size_t row = 0; row < _rows; ++row)
+                for (size_t col = src[row].find_first(); col < _cols; col = src[row].find_next(col))
+                    ret[col][row] = true;
+        }
+        return ret;
+    }
+}
+#endif // ASTD_BIT_MATRIX
\ No newline at end of file
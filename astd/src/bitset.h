@@ -5,6 +5,8 @@
 #include "type_traits.h"
 #include "stringdef.h"
 #include "error.h"
+#include "bit.h"
+#include "simd.h"
 
 /*
 TODOS
@@ -37,9 +39,41 @@ namespace
 
 namespace astd
 {
+    // order of the bits within a byte for bitset::to_bytes / from_bytes
+    enum class bit_order
+    {
+        lsb_first,
+        msb_first
+    };
+
+    template<typename T>
+    [[nodiscard]] constexpr T _bswap_word(T word) noexcept
+    {
+        if constexpr (sizeof(T) == 2)
+            return __builtin_bswap16(word);
+        else if constexpr (sizeof(T) == 4)
+            return __builtin_bswap32(word);
+        else
+            return __builtin_bswap64(word);
+    }
+
+    // reverses the order of the bits within every byte of word
+    template<typename T>
+    [[nodiscard]] constexpr T _reverse_byte_bits(T word) noexcept
+    {
+        word = static_cast<T>(((word >> 4) & static_cast<T>(0x0F0F0F0F0F0F0F0FULL)) | ((word & static_cast<T>(0x0F0F0F0F0F0F0F0FULL)) << 4));
+        word = static_cast<T>(((word >> 2) & static_cast<T>(0x3333333333333333ULL)) | ((word & static_cast<T>(0x3333333333333333ULL)) << 2));
+        word = static_cast<T>(((word >> 1) & static_cast<T>(0x5555555555555555ULL)) | ((word & static_cast<T>(0x5555555555555555ULL)) << 1));
+        return word;
+    }
+
+    struct _bitset_access;
+
     template<size_t _size>
     class bitset
     {
+        friend _bitset_access;
+
     private:
 #ifdef BITSET_BASE_TYPE
         using base_type = BITSET_BASE_TYPE
@@ -171,7 +205,11 @@ namespace astd
 
         [[nodiscard]] bool operator==(const bitset<_size>& other) const noexcept
         {
-            return memcmp(m_data, other.m_data, sizeof(m_data)) == 0;
+            // the trailing bits are always zero, so whole words can be compared
+            if constexpr (s_arrSize == 1)
+                return m_data[0] == other.m_data[0];
+            else
+                return _words_equal(m_data, other.m_data, s_arrSize);
         }
 
         [[nodiscard]] constexpr bool operator[](size_t idx) const
@@ -198,16 +236,27 @@ namespace astd
 
         [[nodiscard]] bool all() const noexcept
         {
-            return count() == _size; //TODO this can be done faster
+            // vacuously true, there is no last word to compare
+            if constexpr (s_arrSize == 0)
+                return true;
+            else if constexpr (s_arrSize == 1)
+                return m_data[0] == s_trailMask;
+            else
+            {
+                // early exit on the first word that is not full, the last one is compared against the trail mask
+                if (!_words_all(m_data, s_arrSize - 1))
+                    return false;
+
+                return m_data[s_arrSize - 1] == s_trailMask;
+            }
         }
 
         [[nodiscard]] bool any() const noexcept
         {
-            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
-                if (m_data[dataIdx] != static_cast<base_type>(0))
-                    return true;
-
-            return false;
+            if constexpr (s_arrSize == 1)
+                return m_data[0] != static_cast<base_type>(0);
+            else
+                return _words_any(m_data, s_arrSize);
         }
 
         [[nodiscard]] bool none() const noexcept
@@ -217,13 +266,34 @@ namespace astd
 
         [[nodiscard]] size_t count() const noexcept
         {
-            size_t result = 0;
+            return _words_popcount(m_data, s_arrSize);
+        }
+
+        // not part of std::bitset, returns size() if no bit is set
+        [[nodiscard]] size_t find_first() const noexcept
+        {
             for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
-                if constexpr (is_same<base_type, unsigned long>::value)
-                    result += __builtin_popcountl(m_data[dataIdx]);
-                else if constexpr (is_same<base_type, unsigned long long>::value)
-                    result += __builtin_popcountll(m_data[dataIdx]);
-            return result;
+                if (m_data[dataIdx] != static_cast<base_type>(0))
+                    return dataIdx * s_bitsInBaseType + countr_zero(m_data[dataIdx]);
+
+            return _size;
+        }
+
+        // not part of std::bitset, returns the first set bit after idx or size() if there is none
+        [[nodiscard]] size_t find_next(size_t idx) const noexcept
+        {
+            if (++idx >= _size)
+                return _size;
+
+            auto dataIdx = idx / s_bitsInBaseType;
+            auto word = m_data[dataIdx] & (s_fullMask << idx % s_bitsInBaseType);
+            while (word == static_cast<base_type>(0))
+            {
+                if (++dataIdx >= s_arrSize)
+                    return _size;
+                word = m_data[dataIdx];
+            }
+            return dataIdx * s_bitsInBaseType + countr_zero(word);
         }
 
         [[nodiscard]] constexpr size_t size() const noexcept
@@ -233,25 +303,19 @@ namespace astd
 
         bitset& operator&=(const bitset& other) noexcept
         {
-            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
-                m_data[dataIdx] &= other.m_data[dataIdx];
-
+            _words_apply<_words_op::bit_and>(m_data, other.m_data, s_arrSize);
             return *this;
         }
 
         bitset& operator|=(const bitset& other) noexcept
         {
-            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
-                m_data[dataIdx] |= other.m_data[dataIdx];
-
+            _words_apply<_words_op::bit_or>(m_data, other.m_data, s_arrSize);
             return *this;
         }
 
         bitset& operator^=(const bitset& other) noexcept
         {
-            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
-                m_data[dataIdx] ^= other.m_data[dataIdx];
-
+            _words_apply<_words_op::bit_xor>(m_data, other.m_data, s_arrSize);
             return *this;
         }
 
@@ -351,6 +415,7 @@ namespace astd
                 m_data[dataIdx] = ~m_data[dataIdx];
 
             sanatize_trail();
+            return *this;
         }
 
         bitset& flip(size_t idx)
@@ -447,6 +512,84 @@ namespace astd
             }
         }
 
+        // number of bytes to_bytes writes and from_bytes reads
+        [[nodiscard]] static constexpr size_t byte_size() noexcept
+        {
+            return s_byteSize;
+        }
+
+        // Writes the bits into byte_size() bytes. With endian::little bit idx ends up in byte idx / 8,
+        // with endian::big the bytes are reversed as for a big endian integer. bit_order selects
+        // whether bit idx % 8 of a byte is counted from its lsb or msb. The default layout is a plain
+        // copy of the storage.
+        template<bit_order _bitOrder = bit_order::lsb_first, endian _byteOrder = endian::little>
+        size_t to_bytes(uint8_t* pOut, size_t len) const
+        {
+            static_assert(endian::native == endian::little, "bitset byte conversion assumes a little endian target");
+            verify(len >= s_byteSize, "buffer too small for bitset::to_bytes");
+
+            if constexpr (_bitOrder == bit_order::lsb_first && _byteOrder == endian::little)
+                memcpy(pOut, m_data, s_byteSize);
+            else
+            {
+                for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                {
+                    auto word = m_data[dataIdx];
+                    if constexpr (_bitOrder == bit_order::msb_first)
+                        word = _reverse_byte_bits(word);
+
+                    const auto first = dataIdx * sizeof(base_type);
+                    const auto count = min(sizeof(base_type), s_byteSize - first);
+                    if constexpr (_byteOrder == endian::little)
+                        memcpy(pOut + first, &word, count);
+                    else
+                    {
+                        word = _bswap_word(word);
+                        memcpy(pOut + s_byteSize - first - count, reinterpret_cast<const uint8_t*>(&word) + sizeof(base_type) - count, count);
+                    }
+                }
+            }
+            return s_byteSize;
+        }
+
+        // Reads byte_size() bytes in the layout to_bytes writes, surplus bits of the last byte are ignored
+        template<bit_order _bitOrder = bit_order::lsb_first, endian _byteOrder = endian::little>
+        bitset& from_bytes(const uint8_t* pIn, size_t len)
+        {
+            static_assert(endian::native == endian::little, "bitset byte conversion assumes a little endian target");
+            verify(len >= s_byteSize, "buffer too small for bitset::from_bytes");
+
+            if constexpr (_bitOrder == bit_order::lsb_first && _byteOrder == endian::little)
+            {
+                if constexpr (s_arrSize > 0)
+                    m_data[s_arrSize - 1] = 0; // bytes of the last word beyond byte_size()
+                memcpy(m_data, pIn, s_byteSize);
+            }
+            else
+            {
+                for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                {
+                    base_type word = 0;
+                    const auto first = dataIdx * sizeof(base_type);
+                    const auto count = min(sizeof(base_type), s_byteSize - first);
+                    if constexpr (_byteOrder == endian::little)
+                        memcpy(&word, pIn + first, count);
+                    else
+                    {
+                        memcpy(reinterpret_cast<uint8_t*>(&word) + sizeof(base_type) - count, pIn + s_byteSize - first - count, count);
+                        word = _bswap_word(word);
+                    }
+
+                    if constexpr (_bitOrder == bit_order::msb_first)
+                        word = _reverse_byte_bits(word);
+                    m_data[dataIdx] = word;
+                }
+            }
+
+            sanatize_trail();
+            return *this;
+        }
+
     private:
         constexpr bool subscr_impl(size_t idx) const noexcept
         {
@@ -468,15 +611,48 @@ namespace astd
         void sanatize_trail() noexcept
         {
             if constexpr (_size % s_bitsInBaseType != 0)
-                m_data[s_arrSize - 1] &= (1 << _size % s_bitsInBaseType) - 1;
+                m_data[s_arrSize - 1] &= s_trailMask;
         }
 
         static constexpr size_t s_bitsInBaseType = 8 * sizeof(base_type);
         static constexpr size_t s_arrSize = _size == 0 ? 0 : (_size - 1) / s_bitsInBaseType + 1;
+        static constexpr size_t s_byteSize = (_size + 7) / 8;
+        static constexpr base_type s_fullMask = ~static_cast<base_type>(0);
+        // valid bits of the last storage word
+        static constexpr base_type s_trailMask = _size % s_bitsInBaseType == 0 ? s_fullMask
+            : (static_cast<base_type>(1) << _size % s_bitsInBaseType) - 1;
 
         base_type m_data[s_arrSize];
     };
 
+    // gives the types built on top of bitset access to its word storage
+    struct _bitset_access
+    {
+        template<size_t _size>
+        struct _word_type_impl
+        {
+            using type = typename bitset<_size>::base_type;
+        };
+
+        template<size_t _size>
+        using word_type = typename _word_type_impl<_size>::type;
+
+        template<size_t _size>
+        static constexpr size_t word_count = bitset<_size>::s_arrSize;
+
+        template<size_t _size>
+        [[nodiscard]] static constexpr word_type<_size>* words(bitset<_size>& bs) noexcept
+        {
+            return bs.m_data;
+        }
+
+        template<size_t _size>
+        [[nodiscard]] static constexpr const word_type<_size>* words(const bitset<_size>& bs) noexcept
+        {
+            return bs.m_data;
+        }
+    };
+
 
     template<size_t _size>
     bitset<_size> operator&(const bitset<_size>& lhs, const bitset<_size>& rhs) noexcept
@@ -0,0 +1,477 @@
+#pragma once
+#ifndef ASTD_BITSET_VIEW
+#define ASTD_BITSET_VIEW
+#include "bitset.h"
+#include "progmem.h"
+#include "type_traits.h"
+#include "error.h"
+
+/*
+bitset_view is not part of the STL. It applies the bitset API to memory it does not own, like a
+received packet, an I/O register or a table in flash, so the bits do not have to be copied into a
+bitset and back out again.
+
+Bit idx is located in word idx / bits_per_word at position idx % bits_per_word, which is the layout
+bitset uses as well. Bits of the last word beyond _size are masked on reads and never written, so a
+view can cover only a part of a register or of the last byte of a buffer.
+
+bitset_view<_size, T>           read/write view over words of type T
+const_bitset_view<_size, T>     read only view
+volatile_bitset_view<_size, T>  read/write view over volatile words, e.g. I/O registers. Every
+                                operation loads and stores each word at most once and never goes
+                                through memset/memcmp. Read-modify-write is not atomic, guard
+                                against ISRs touching the same register yourself
+progmem_bitset_view<_size, T>   read only view over data placed in PROGMEM
+
+Binary operations and comparisons accept a bitset or any view of the same size, regardless of the
+word type of the other operand.
+*/
+
+namespace astd
+{
+    // load policy for views over ordinary (possibly volatile) memory
+    struct _ram_loader
+    {
+        template<typename T>
+        static constexpr remove_cv_t<T> load(const T* pWord) noexcept
+        {
+            return *pWord;
+        }
+    };
+
+    template<size_t _size, typename T, typename Loader>
+    class _bitset_view_base;
+
+    template<size_t _size, typename T = uint8_t>
+    class bitset_view;
+
+    template<size_t _size>
+    constexpr _bitset_view_base<_size, const _bitset_access::word_type<_size>, _ram_loader> _bitset_view_of(const bitset<_size>& bs) noexcept;
+
+    template<size_t _size, typename T, typename Loader>
+    constexpr const _bitset_view_base<_size, T, Loader>& _bitset_view_of(const _bitset_view_base<_size, T, Loader>& view) noexcept;
+
+    template<size_t _size, typename T, typename Loader>
+    class _bitset_view_base
+    {
+        template<size_t, typename, typename>
+        friend class _bitset_view_base;
+
+        template<size_t, typename>
+        friend class bitset_view;
+
+    public:
+        using word_type = remove_cv_t<T>;
+        static_assert(static_cast<word_type>(-1) > static_cast<word_type>(0), "bitset_view needs an unsigned word type");
+
+        constexpr explicit _bitset_view_base(T* pData) noexcept
+            :m_pData(pData)
+        {}
+
+        template<size_t _len>
+        constexpr _bitset_view_base(T(&data)[_len]) noexcept
+            :m_pData(data)
+        {
+            static_assert(_len >= s_arrSize, "buffer too small for bitset_view");
+        }
+
+        template<typename Other>
+        [[nodiscard]] bool operator==(const Other& other) const noexcept
+        {
+            const auto& otherView = _bitset_view_of<_size>(other);
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                if (load_masked(dataIdx) != otherView.template extract_impl<word_type>(dataIdx))
+                    return false;
+
+            return true;
+        }
+
+        template<typename Other>
+        [[nodiscard]] bool operator!=(const Other& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] constexpr bool operator[](size_t idx) const
+        {
+#if _DEBUG
+            verify(idx < _size, "bitset_view subscript out of range");
+#endif
+            return subscr_impl(idx);
+        }
+
+        [[nodiscard]] bool test(size_t idx) const
+        {
+            verify(idx < _size, "invalid bitset_view index");
+            return subscr_impl(idx);
+        }
+
+        [[nodiscard]] bool all() const noexcept
+        {
+            if constexpr (s_arrSize == 0)
+                return true;
+            else
+            {
+                for (size_t dataIdx = 0; dataIdx < s_arrSize - 1; ++dataIdx)
+                    if (load_word(dataIdx) != s_fullMask)
+                        return false;
+
+                return load_masked(s_arrSize - 1) == s_trailMask;
+            }
+        }
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                if (load_masked(dataIdx) != static_cast<word_type>(0))
+                    return true;
+
+            return false;
+        }
+
+        [[nodiscard]] bool none() const noexcept
+        {
+            return !any();
+        }
+
+        [[nodiscard]] size_t count() const noexcept
+        {
+            size_t result = 0;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                result += popcount(load_masked(dataIdx));
+            return result;
+        }
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        // returns size() if no bit is set
+        [[nodiscard]] size_t find_first() const noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+            {
+                const auto word = load_masked(dataIdx);
+                if (word != static_cast<word_type>(0))
+                    return dataIdx * s_bitsInWord + countr_zero(word);
+            }
+            return _size;
+        }
+
+        // returns the first set bit after idx or size() if there is none
+        [[nodiscard]] size_t find_next(size_t idx) const noexcept
+        {
+            if (++idx >= _size)
+                return _size;
+
+            auto dataIdx = idx / s_bitsInWord;
+            auto word = static_cast<word_type>(load_masked(dataIdx) & (s_fullMask << idx % s_bitsInWord));
+            while (word == static_cast<word_type>(0))
+            {
+                if (++dataIdx >= s_arrSize)
+                    return _size;
+                word = load_masked(dataIdx);
+            }
+            return dataIdx * s_bitsInWord + countr_zero(word);
+        }
+
+        [[nodiscard]] bitset<_size> to_bitset() const noexcept
+        {
+            using bitset_word = _bitset_access::word_type<_size>;
+
+            bitset<_size> ret;
+            auto* pWords = _bitset_access::words(ret);
+            for (size_t dataIdx = 0; dataIdx < _bitset_access::word_count<_size>; ++dataIdx)
+                pWords[dataIdx] = extract_impl<bitset_word>(dataIdx);
+            return ret;
+        }
+
+        [[nodiscard]] constexpr T* data() const noexcept
+        {
+            return m_pData;
+        }
+
+    protected:
+        [[nodiscard]] constexpr word_type load_word(size_t dataIdx) const noexcept
+        {
+            return Loader::load(m_pData + dataIdx);
+        }
+
+        [[nodiscard]] constexpr word_type load_masked(size_t dataIdx) const noexcept
+        {
+            if constexpr (s_trailMask != s_fullMask)
+            {
+                if (dataIdx == s_arrSize - 1)
+                    return load_word(dataIdx) & s_trailMask;
+            }
+            return load_word(dataIdx);
+        }
+
+        constexpr bool subscr_impl(size_t idx) const noexcept
+        {
+            return (load_word(idx / s_bitsInWord) & static_cast<word_type>(static_cast<word_type>(1) << idx % s_bitsInWord)) != static_cast<word_type>(0);
+        }
+
+        // bits [chunkIdx * bits(W), (chunkIdx + 1) * bits(W)) of the view, zero beyond _size
+        template<typename W>
+        [[nodiscard]] W extract_impl(size_t chunkIdx) const noexcept
+        {
+            if constexpr (sizeof(W) == sizeof(word_type))
+                return static_cast<W>(load_masked(chunkIdx));
+            else if constexpr (sizeof(W) > sizeof(word_type))
+            {
+                constexpr auto ratio = sizeof(W) / sizeof(word_type);
+                W ret = 0;
+                for (size_t part = 0; part < ratio; ++part)
+                {
+                    const auto dataIdx = chunkIdx * ratio + part;
+                    if (dataIdx < s_arrSize)
+                        ret |= static_cast<W>(load_masked(dataIdx)) << (part * s_bitsInWord);
+                }
+                return ret;
+            }
+            else
+            {
+                constexpr auto ratio = sizeof(word_type) / sizeof(W);
+                return static_cast<W>(load_masked(chunkIdx / ratio) >> (chunkIdx % ratio * 8 * sizeof(W)));
+            }
+        }
+
+        static constexpr size_t s_bitsInWord = 8 * sizeof(word_type);
+        static constexpr size_t s_arrSize = _size == 0 ? 0 : (_size - 1) / s_bitsInWord + 1;
+        static constexpr word_type s_fullMask = static_cast<word_type>(~static_cast<word_type>(0));
+        static constexpr word_type s_trailMask = _size % s_bitsInWord == 0 ? s_fullMask
+            : static_cast<word_type>((static_cast<word_type>(1) << _size % s_bitsInWord) - 1);
+
+        T* m_pData;
+    };
+
+    template<size_t _size, typename T>
+    class bitset_view : public _bitset_view_base<_size, T, _ram_loader>
+    {
+    private:
+        using base = _bitset_view_base<_size, T, _ram_loader>;
+        static_assert(!is_const_v<T>, "use const_bitset_view for read only data");
+
+    public:
+        using typename base::word_type;
+
+        class reference
+        {
+            friend bitset_view;
+
+        public:
+            reference& operator=(bool val) noexcept
+            {
+                // written out, compound assignment to volatile words is deprecated since C++20
+                if (val)
+                    *m_pWord = static_cast<word_type>(*m_pWord | m_mask);
+                else
+                    *m_pWord = static_cast<word_type>(*m_pWord & ~m_mask);
+                return *this;
+            }
+
+            reference& operator=(const reference& ref) noexcept
+            {
+                return *this = static_cast<bool>(ref);
+            }
+
+            operator bool() const noexcept
+            {
+                return (*m_pWord & m_mask) != static_cast<word_type>(0);
+            }
+
+            [[nodiscard]] bool operator~() const noexcept
+            {
+                return !static_cast<bool>(*this);
+            }
+
+            reference& flip() noexcept
+            {
+                *m_pWord = static_cast<word_type>(*m_pWord ^ m_mask);
+                return *this;
+            }
+
+        private:
+            reference(T* pWord, word_type mask) noexcept
+                :m_pWord(pWord), m_mask(mask)
+            {}
+
+            T* m_pWord;
+            word_type m_mask;
+        };
+
+        using base::base;
+
+        operator _bitset_view_base<_size, const T, _ram_loader>() const noexcept
+        {
+            return _bitset_view_base<_size, const T, _ram_loader>(this->m_pData);
+        }
+
+        using base::operator[];
+
+        [[nodiscard]] reference operator[](size_t idx)
+        {
+#if _DEBUG
+            verify(idx < _size, "bitset_view subscript out of range");
+#endif
+            return reference(this->m_pData + idx / base::s_bitsInWord, bit_mask(idx));
+        }
+
+        template<typename Other>
+        bitset_view& operator&=(const Other& other) noexcept
+        {
+            const auto& otherView = _bitset_view_of<_size>(other);
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+            {
+                const auto word = this->load_word(dataIdx);
+                store_word(dataIdx, word, word & otherView.template extract_impl<word_type>(dataIdx));
+            }
+            return *this;
+        }
+
+        template<typename Other>
+        bitset_view& operator|=(const Other& other) noexcept
+        {
+            const auto& otherView = _bitset_view_of<_size>(other);
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+            {
+                const auto word = this->load_word(dataIdx);
+                store_word(dataIdx, word, word | otherView.template extract_impl<word_type>(dataIdx));
+            }
+            return *this;
+        }
+
+        template<typename Other>
+        bitset_view& operator^=(const Other& other) noexcept
+        {
+            const auto& otherView = _bitset_view_of<_size>(other);
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+            {
+                const auto word = this->load_word(dataIdx);
+                store_word(dataIdx, word, word ^ otherView.template extract_impl<word_type>(dataIdx));
+            }
+            return *this;
+        }
+
+        // copies the bits of other into the viewed memory
+        template<typename Other>
+        bitset_view& assign(const Other& other) noexcept
+        {
+            const auto& otherView = _bitset_view_of<_size>(other);
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+                store_word(dataIdx, otherView.template extract_impl<word_type>(dataIdx));
+            return *this;
+        }
+
+        bitset_view& set() noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+                store_word(dataIdx, base::s_fullMask);
+            return *this;
+        }
+
+        bitset_view& set(size_t idx, bool value = true)
+        {
+            verify(idx < _size, "invalid bitset_view index");
+            set_impl(idx, value);
+            return *this;
+        }
+
+        bitset_view& reset() noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+                store_word(dataIdx, static_cast<word_type>(0));
+            return *this;
+        }
+
+        bitset_view& reset(size_t idx)
+        {
+            verify(idx < _size, "invalid bitset_view index");
+            set_impl(idx, false);
+            return *this;
+        }
+
+        bitset_view& flip() noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < base::s_arrSize; ++dataIdx)
+            {
+                const auto word = this->load_word(dataIdx);
+                store_word(dataIdx, word, static_cast<word_type>(~word));
+            }
+            return *this;
+        }
+
+        bitset_view& flip(size_t idx)
+        {
+            verify(idx < _size, "invalid bitset_view index");
+            auto& word = this->m_pData[idx / base::s_bitsInWord];
+            word = static_cast<word_type>(word ^ bit_mask(idx));
+            return *this;
+        }
+
+    private:
+        static constexpr word_type bit_mask(size_t idx) noexcept
+        {
+            return static_cast<word_type>(static_cast<word_type>(1) << idx % base::s_bitsInWord);
+        }
+
+        void set_impl(size_t idx, bool val) noexcept
+        {
+            // one load and one store, also for volatile words
+            auto& word = this->m_pData[idx / base::s_bitsInWord];
+            if (val)
+                word = static_cast<word_type>(word | bit_mask(idx));
+            else
+                word = static_cast<word_type>(word & ~bit_mask(idx));
+        }
+
+        // stores val while keeping the bits of the last word beyond _size, oldVal has to be the
+        // current content of the word so it does not have to be loaded twice
+        void store_word(size_t dataIdx, word_type oldVal, word_type val) noexcept
+        {
+            if constexpr (base::s_trailMask != base::s_fullMask)
+            {
+                if (dataIdx == base::s_arrSize - 1)
+                    val = (oldVal & static_cast<word_type>(~base::s_trailMask)) | (val & base::s_trailMask);
+            }
+            this->m_pData[dataIdx] = val;
+        }
+
+        void store_word(size_t dataIdx, word_type val) noexcept
+        {
+            if constexpr (base::s_trailMask != base::s_fullMask)
+            {
+                if (dataIdx == base::s_arrSize - 1)
+                {
+                    store_word(dataIdx, this->load_word(dataIdx), val);
+                    return;
+                }
+            }
+            this->m_pData[dataIdx] = val;
+        }
+    };
+
+    template<size_t _size, typename T = uint8_t>
+    using const_bitset_view = _bitset_view_base<_size, const T, _ram_loader>;
+
+    template<size_t _size, typename T = uint8_t>
+    using volatile_bitset_view = bitset_view<_size, volatile T>;
+
+    template<size_t _size, typename T = uint8_t>
+    using progmem_bitset_view = _bitset_view_base<_size, const T, _pgm_loader>;
+
+    template<size_t _size>
+    constexpr _bitset_view_base<_size, const _bitset_access::word_type<_size>, _ram_loader> _bitset_view_of(const bitset<_size>& bs) noexcept
+    {
+        return _bitset_view_base<_size, const _bitset_access::word_type<_size>, _ram_loader>(_bitset_access::words(bs));
+    }
+
+    template<size_t _size, typename T, typename Loader>
+    constexpr const _bitset_view_base<_size, T, Loader>& _bitset_view_of(const _bitset_view_base<_size, T, Loader>& view) noexcept
+    {
+        return view;
+    }
+}
+#endif // ASTD_BITSET_VIEW
\ No newline at end of file
@@ -0,0 +1,266 @@
+#pragma once
+#ifndef ASTD_BLOOM_FILTER
+#define ASTD_BLOOM_FILTER
+#include "bitset.h"
+#include "packed_array.h"
+
+/*
+bloom_filter is not part of the STL. It answers "was this key inserted before?" in O(_k) with a fixed
+amount of memory, at the price of false positives (never false negatives). With n inserted keys the
+false positive rate is about (1 - e^(-_k * n / _bits))^_k, so _k = 0.7 * _bits / n is a good choice.
+
+The _k positions of a key are derived from a single 32 bit hash by double hashing, so inserting or
+testing costs one hash and two reductions modulo _bits. Choose _bits as a power of two to turn
+those into masks and to get _k distinct positions for every key (as long as _k <= _bits). For other
+sizes a prime is best, otherwise a step sharing a factor with _bits can revisit positions.
+
+counting_bloom_filter replaces every bit by a 4 bit counter stored in a packed_array and thus
+supports remove(). Counters saturate at 15 and are never decremented from there, removing a key
+that was not inserted is ignored if it is not possibly contained.
+*/
+
+namespace astd
+{
+    // murmur3 finalizer, cheap and good enough to spread sequential IDs
+    [[nodiscard]] constexpr uint32_t _bloom_hash(uint32_t key) noexcept
+    {
+        key ^= key >> 16;
+        key *= 0x85EBCA6BUL;
+        key ^= key >> 13;
+        key *= 0xC2B2AE35UL;
+        key ^= key >> 16;
+        return key;
+    }
+
+    // FNV-1a for byte strings
+    [[nodiscard]] inline uint32_t _bloom_hash(const void* pData, size_t len) noexcept
+    {
+        auto hash = static_cast<uint32_t>(2166136261UL);
+        const auto* pByte = static_cast<const uint8_t*>(pData);
+        for (const auto* end = pByte + len; pByte < end; ++pByte)
+        {
+            hash ^= *pByte;
+            hash *= 16777619UL;
+        }
+        return _bloom_hash(hash);
+    }
+
+    // iterates the _k positions of a hash as h1 + i * h2 (mod _size). h1 is the whole hash, h2 the hash
+    // rotated by 16 bits and mapped into [1, _size - 1], odd for powers of two so it is coprime to _size
+    template<size_t _size>
+    class _bloom_positions
+    {
+        static constexpr bool s_isPow2 = (_size & (_size - 1)) == 0;
+
+    public:
+        constexpr explicit _bloom_positions(uint32_t hash) noexcept
+            :m_pos(hash % _size), m_step(step((hash >> 16) | (hash << 16)))
+        {}
+
+        [[nodiscard]] constexpr size_t operator*() const noexcept
+        {
+            return m_pos;
+        }
+
+        constexpr _bloom_positions& operator++() noexcept
+        {
+            m_pos += m_step;
+            if (m_pos >= _size)
+                m_pos -= _size;
+            return *this;
+        }
+
+    private:
+        [[nodiscard]] static constexpr size_t step(uint32_t hash) noexcept
+        {
+            if constexpr (_size == 1)
+                return 0;
+            else if constexpr (s_isPow2)
+                return (hash | 1UL) % _size;
+            else
+                return 1 + hash % (_size - 1);
+        }
+
+        size_t m_pos;
+        size_t m_step;
+    };
+
+    template<size_t _bits, size_t _k>
+    class bloom_filter
+    {
+        static_assert(_bits > 0 && _k > 0, "bloom_filter needs at least one bit and one hash");
+
+    public:
+        constexpr bloom_filter() noexcept = default;
+
+        // returns true if the key was definitely not contained before
+        bool insert(uint32_t key) noexcept
+        {
+            return insert_hash(_bloom_hash(key));
+        }
+
+        bool insert(const void* pData, size_t len) noexcept
+        {
+            return insert_hash(_bloom_hash(pData, len));
+        }
+
+        [[nodiscard]] bool contains(uint32_t key) const noexcept
+        {
+            return contains_hash(_bloom_hash(key));
+        }
+
+        [[nodiscard]] bool contains(const void* pData, size_t len) const noexcept
+        {
+            return contains_hash(_bloom_hash(pData, len));
+        }
+
+        void clear() noexcept
+        {
+            m_bits.reset();
+        }
+
+        // number of set bits, to estimate how saturated the filter is
+        [[nodiscard]] size_t count() const noexcept
+        {
+            return m_bits.count();
+        }
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return _bits;
+        }
+
+        [[nodiscard]] const bitset<_bits>& bits() const noexcept
+        {
+            return m_bits;
+        }
+
+    private:
+        bool insert_hash(uint32_t hash) noexcept
+        {
+            bool inserted = false;
+            _bloom_positions<_bits> pos(hash);
+            for (size_t hashIdx = 0; hashIdx < _k; ++hashIdx, ++pos)
+            {
+                auto bit = m_bits[*pos];
+                if (!bit)
+                {
+                    bit = true;
+                    inserted = true;
+                }
+            }
+            return inserted;
+        }
+
+        bool contains_hash(uint32_t hash) const noexcept
+        {
+            _bloom_positions<_bits> pos(hash);
+            for (size_t hashIdx = 0; hashIdx < _k; ++hashIdx, ++pos)
+                if (!m_bits[*pos])
+                    return false;
+
+            return true;
+        }
+
+        bitset<_bits> m_bits;
+    };
+
+    template<size_t _size, size_t _k>
+    class counting_bloom_filter
+    {
+        static_assert(_size > 0 && _k > 0, "counting_bloom_filter needs at least one counter and one hash");
+
+    public:
+        constexpr counting_bloom_filter() noexcept = default;
+
+        // returns true if the key was definitely not contained before
+        bool insert(uint32_t key) noexcept
+        {
+            return insert_hash(_bloom_hash(key));
+        }
+
+        bool insert(const void* pData, size_t len) noexcept
+        {
+            return insert_hash(_bloom_hash(pData, len));
+        }
+
+        // returns false if the key was definitely not contained
+        bool remove(uint32_t key) noexcept
+        {
+            return remove_hash(_bloom_hash(key));
+        }
+
+        bool remove(const void* pData, size_t len) noexcept
+        {
+            return remove_hash(_bloom_hash(pData, len));
+        }
+
+        [[nodiscard]] bool contains(uint32_t key) const noexcept
+        {
+            return contains_hash(_bloom_hash(key));
+        }
+
+        [[nodiscard]] bool contains(const void* pData, size_t len) const noexcept
+        {
+            return contains_hash(_bloom_hash(pData, len));
+        }
+
+        void clear() noexcept
+        {
+            m_counters.fill(0);
+        }
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return _size;
+        }
+
+    private:
+        bool insert_hash(uint32_t hash) noexcept
+        {
+            bool inserted = false;
+            _bloom_positions<_size> pos(hash);
+            for (size_t hashIdx = 0; hashIdx < _k; ++hashIdx, ++pos)
+            {
+                auto counter = m_counters[*pos];
+                const auto val = static_cast<uint8_t>(counter);
+                if (val == 0)
+                    inserted = true;
+                if (val != s_saturated)
+                    counter = static_cast<uint8_t>(val + 1);
+            }
+            return inserted;
+        }
+
+        bool remove_hash(uint32_t hash) noexcept
+        {
+            if (!contains_hash(hash))
+                return false;
+
+            _bloom_positions<_size> pos(hash);
+            for (size_t hashIdx = 0; hashIdx < _k; ++hashIdx, ++pos)
+            {
+                auto counter = m_counters[*pos];
+                const auto val = static_cast<uint8_t>(counter);
+                if (val != s_saturated)
+                    counter = static_cast<uint8_t>(val - 1);
+            }
+            return true;
+        }
+
+        bool contains_hash(uint32_t hash) const noexcept
+        {
+            _bloom_positions<_size> pos(hash);
+            for (size_t hashIdx = 0; hashIdx < _k; ++hashIdx, ++pos)
+                if (m_counters[*pos] == 0)
+                    return false;
+
+            return true;
+        }
+
+        static constexpr uint8_t s_saturated = 15;
+
+        packed_array<4, _size> m_counters;
+    };
+}
+#endif // ASTD_BLOOM_FILTER
\ No newline at end of file
@@ -0,0 +1,530 @@
+#pragma once
+#ifndef ASTD_COMPRESSED_BITSET
+#define ASTD_COMPRESSED_BITSET
+#include "bitset.h"
+#include "type_traits.h"
+#include "error.h"
+
+/*
+compressed_bitset is not part of the STL. It is a roaring style bitset for large, sparse universes.
+The _size bits are split into chunks of 256 bits and every chunk is stored in whichever container is
+the smallest for its content:
+
+empty       no bits set, takes no memory
+array       sorted list of the set bit offsets, one byte per set bit
+bitmap      the 32 bytes of the chunk
+runs        sorted (first, last) byte pairs of consecutive set bits, e.g. a full chunk takes 2 bytes
+
+The containers are packed back to back into a pool of _poolBytes bytes, there is no heap involved.
+So instead of _size / 8 bytes the memory used is the pool plus 2-3 bytes per chunk, and the pool only
+has to hold what the set bits need. Running out of pool space is a runtime error.
+
+Every modification decodes the affected chunk into a 32 byte buffer, applies the change and encodes
+it again, so the representation of a given content is always the same. test() works on the
+containers directly. The whole set operations set(), flip(), ~, &, |, ^ and the shifts rebuild every
+chunk, one 32 byte buffer at a time. The binary operators return a bitset with the pool of lhs.
+*/
+
+namespace astd
+{
+    enum class _compressed_container : uint8_t
+    {
+        empty,
+        array,
+        bitmap,
+        runs
+    };
+
+    template<size_t _size, size_t _poolBytes>
+    class compressed_bitset
+    {
+        static_assert(_size > 0, "compressed_bitset needs at least one bit");
+        static_assert(_poolBytes <= 0xFFFF, "compressed_bitset pool is limited to 65535 bytes");
+
+        template<size_t, size_t>
+        friend class compressed_bitset;
+
+    public:
+        constexpr compressed_bitset() noexcept
+            :m_types{}, m_offsets{}, m_pool{}
+        {}
+
+        template<size_t _otherPool>
+        [[nodiscard]] bool operator==(const compressed_bitset<_size, _otherPool>& other) const noexcept
+        {
+            // the encoding only depends on the content, so equal chunks have equal bytes
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                if (m_types[chunk] != other.m_types[chunk] || chunk_bytes(chunk) != other.chunk_bytes(chunk))
+                    return false;
+                if (memcmp(m_pool + m_offsets[chunk], other.m_pool + other.m_offsets[chunk], chunk_bytes(chunk)) != 0)
+                    return false;
+            }
+            return true;
+        }
+
+        template<size_t _otherPool>
+        [[nodiscard]] bool operator!=(const compressed_bitset<_size, _otherPool>& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] bool operator[](size_t idx) const
+        {
+#if _DEBUG
+            verify(idx < _size, "compressed_bitset subscript out of range");
+#endif
+            return test_impl(idx / s_chunkBits, static_cast<uint8_t>(idx % s_chunkBits));
+        }
+
+        [[nodiscard]] bool test(size_t idx) const
+        {
+            verify(idx < _size, "invalid compressed_bitset index");
+            return test_impl(idx / s_chunkBits, static_cast<uint8_t>(idx % s_chunkBits));
+        }
+
+        // stops at the first chunk that is not full
+        [[nodiscard]] bool all() const noexcept
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+                if (chunk_count(chunk) != chunk_bits(chunk))
+                    return false;
+            return true;
+        }
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            return m_offsets[s_chunkCount] != 0;
+        }
+
+        [[nodiscard]] bool none() const noexcept
+        {
+            return !any();
+        }
+
+        [[nodiscard]] size_t count() const noexcept
+        {
+            size_t result = 0;
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+                result += chunk_count(chunk);
+            return result;
+        }
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return _size;
+        }
+
+        // bytes of the pool currently in use
+        [[nodiscard]] size_t pool_usage() const noexcept
+        {
+            return m_offsets[s_chunkCount];
+        }
+
+        // returns size() if no bit is set
+        [[nodiscard]] size_t find_first() const noexcept
+        {
+            return find_from(0);
+        }
+
+        // returns the first set bit after idx or size() if there is none
+        [[nodiscard]] size_t find_next(size_t idx) const noexcept
+        {
+            return idx + 1 >= _size ? _size : find_from(idx + 1);
+        }
+
+        compressed_bitset& set(size_t idx, bool value = true)
+        {
+            verify(idx < _size, "invalid compressed_bitset index");
+
+            const auto chunk = idx / s_chunkBits;
+            const auto bit = static_cast<uint8_t>(idx % s_chunkBits);
+            if (test_impl(chunk, bit) == value)
+                return *this;
+
+            uint8_t buffer[s_chunkBytes];
+            decode(chunk, buffer);
+            if (value)
+                buffer[bit / 8] |= static_cast<uint8_t>(1 << bit % 8);
+            else
+                buffer[bit / 8] &= static_cast<uint8_t>(~(1 << bit % 8));
+            encode(chunk, buffer);
+            return *this;
+        }
+
+        // a full chunk is a single run, so this takes 2 bytes of the pool per chunk
+        compressed_bitset& set()
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                uint8_t buffer[s_chunkBytes];
+                valid_mask(chunk, buffer);
+                encode(chunk, buffer);
+            }
+            return *this;
+        }
+
+        compressed_bitset& reset(size_t idx)
+        {
+            return set(idx, false);
+        }
+
+        compressed_bitset& reset() noexcept
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                m_types[chunk] = container::empty;
+                m_offsets[chunk + 1] = 0;
+            }
+            return *this;
+        }
+
+        compressed_bitset& flip(size_t idx)
+        {
+            return set(idx, !test(idx));
+        }
+
+        compressed_bitset& flip()
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                uint8_t buffer[s_chunkBytes];
+                uint8_t mask[s_chunkBytes];
+                decode(chunk, buffer);
+                valid_mask(chunk, mask);
+                for (size_t byteIdx = 0; byteIdx < s_chunkBytes; ++byteIdx)
+                    buffer[byteIdx] ^= mask[byteIdx];
+                encode(chunk, buffer);
+            }
+            return *this;
+        }
+
+        [[nodiscard]] compressed_bitset operator~() const
+        {
+            return compressed_bitset(*this).flip();
+        }
+
+        [[nodiscard]] compressed_bitset operator<<(size_t offset) const
+        {
+            return compressed_bitset(*this) <<= offset;
+        }
+
+        compressed_bitset& operator<<=(size_t offset)
+        {
+            return shift(offset, true);
+        }
+
+        [[nodiscard]] compressed_bitset operator>>(size_t offset) const
+        {
+            return compressed_bitset(*this) >>= offset;
+        }
+
+        compressed_bitset& operator>>=(size_t offset)
+        {
+            return shift(offset, false);
+        }
+
+        template<size_t _otherPool>
+        compressed_bitset& operator&=(const compressed_bitset<_size, _otherPool>& other)
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                if (m_types[chunk] == container::empty)
+                    continue;
+                combine(chunk, other, [](uint8_t lhs, uint8_t rhs) { return static_cast<uint8_t>(lhs & rhs); });
+            }
+            return *this;
+        }
+
+        template<size_t _otherPool>
+        compressed_bitset& operator|=(const compressed_bitset<_size, _otherPool>& other)
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                if (other.m_types[chunk] == container::empty)
+                    continue;
+                combine(chunk, other, [](uint8_t lhs, uint8_t rhs) { return static_cast<uint8_t>(lhs | rhs); });
+            }
+            return *this;
+        }
+
+        template<size_t _otherPool>
+        compressed_bitset& operator^=(const compressed_bitset<_size, _otherPool>& other)
+        {
+            for (size_t chunk = 0; chunk < s_chunkCount; ++chunk)
+            {
+                if (other.m_types[chunk] == container::empty)
+                    continue;
+                combine(chunk, other, [](uint8_t lhs, uint8_t rhs) { return static_cast<uint8_t>(lhs ^ rhs); });
+            }
+            return *this;
+        }
+
+    private:
+        using container = _compressed_container;
+
+        static constexpr size_t s_chunkBits = 256;
+        static constexpr size_t s_chunkBytes = s_chunkBits / 8;
+        static constexpr size_t s_chunkCount = (_size - 1) / s_chunkBits + 1;
+
+        using offset_type = conditional_t<_poolBytes <= 0xFF, uint8_t, uint16_t>;
+
+        [[nodiscard]] size_t chunk_bytes(size_t chunk) const noexcept
+        {
+            return m_offsets[chunk + 1] - m_offsets[chunk];
+        }
+
+        // bits of the chunk inside _size, only the last chunk can be shorter
+        [[nodiscard]] static constexpr size_t chunk_bits(size_t chunk) noexcept
+        {
+            return chunk + 1 < s_chunkCount || _size % s_chunkBits == 0 ? s_chunkBits : _size % s_chunkBits;
+        }
+
+        [[nodiscard]] size_t chunk_count(size_t chunk) const noexcept
+        {
+            const auto* pData = m_pool + m_offsets[chunk];
+            const auto len = chunk_bytes(chunk);
+            size_t result = 0;
+            switch (m_types[chunk])
+            {
+            case container::array:
+                result = len;
+                break;
+            case container::bitmap:
+                for (size_t byteIdx = 0; byteIdx < len; ++byteIdx)
+                    result += popcount(pData[byteIdx]);
+                break;
+            case container::runs:
+                for (size_t byteIdx = 0; byteIdx < len; byteIdx += 2)
+                    result += pData[byteIdx + 1] - pData[byteIdx] + 1;
+                break;
+            default:
+                break;
+            }
+            return result;
+        }
+
+        // the bits of the chunk inside _size set, the ones behind cleared
+        static void valid_mask(size_t chunk, uint8_t(&buffer)[s_chunkBytes]) noexcept
+        {
+            const auto bits = chunk_bits(chunk);
+            memset(buffer, 0x00, s_chunkBytes);
+            memset(buffer, 0xFF, bits / 8);
+            if (bits % 8 != 0)
+                buffer[bits / 8] = static_cast<uint8_t>((1 << bits % 8) - 1);
+        }
+
+        // rebuilds chunk by chunk, the chunks are processed in the order in which their sources are not
+        // overwritten yet, so every bit of a target chunk comes from at most two decoded source chunks
+        compressed_bitset& shift(size_t offset, bool left)
+        {
+            if (offset == 0)
+                return *this;
+            if (offset >= _size)
+                return reset();
+
+            for (size_t step = 0; step < s_chunkCount; ++step)
+            {
+                const auto chunk = left ? s_chunkCount - 1 - step : step;
+                // source of the first bit of the chunk, before bit 0 for left shifts of the low chunks
+                const auto first = static_cast<ptrdiff_t>(chunk * s_chunkBits) + (left ? -static_cast<ptrdiff_t>(offset) : static_cast<ptrdiff_t>(offset));
+                // the chunk containing first, rounded down also for negative positions
+                const ptrdiff_t chunkBits = s_chunkBits;
+                const ptrdiff_t base = first >= 0 ? first / chunkBits : -((chunkBits - 1 - first) / chunkBits);
+
+                uint8_t window[2][s_chunkBytes];
+                for (ptrdiff_t idx = 0; idx < 2; ++idx)
+                {
+                    if (base + idx >= 0 && base + idx < static_cast<ptrdiff_t>(s_chunkCount))
+                        decode(static_cast<size_t>(base + idx), window[idx]);
+                    else
+                        memset(window[idx], 0x00, s_chunkBytes);
+                }
+
+                uint8_t buffer[s_chunkBytes] = {};
+                const auto start = static_cast<size_t>(first - base * chunkBits);
+                for (size_t bit = 0; bit < chunk_bits(chunk); ++bit)
+                {
+                    const auto src = start + bit;
+                    const auto srcByte = window[src / s_chunkBits][src % s_chunkBits / 8];
+                    if ((srcByte & (1 << src % 8)) != 0)
+                        buffer[bit / 8] |= static_cast<uint8_t>(1 << bit % 8);
+                }
+                encode(chunk, buffer);
+            }
+            return *this;
+        }
+
+        bool test_impl(size_t chunk, uint8_t bit) const noexcept
+        {
+            const auto* pData = m_pool + m_offsets[chunk];
+            const auto len = chunk_bytes(chunk);
+            switch (m_types[chunk])
+            {
+            case container::array:
+                for (size_t byteIdx = 0; byteIdx < len && pData[byteIdx] <= bit; ++byteIdx)
+                    if (pData[byteIdx] == bit)
+                        return true;
+                return false;
+            case container::bitmap:
+                return (pData[bit / 8] & (1 << bit % 8)) != 0;
+            case container::runs:
+                for (size_t byteIdx = 0; byteIdx < len && pData[byteIdx] <= bit; byteIdx += 2)
+                    if (bit <= pData[byteIdx + 1])
+                        return true;
+                return false;
+            default:
+                return false;
+            }
+        }
+
+        void decode(size_t chunk, uint8_t(&buffer)[s_chunkBytes]) const noexcept
+        {
+            const auto* pData = m_pool + m_offsets[chunk];
+            const auto len = chunk_bytes(chunk);
+            switch (m_types[chunk])
+            {
+            case container::bitmap:
+                memcpy(buffer, pData, s_chunkBytes);
+                return;
+            case container::array:
+                memset(buffer, 0x00, s_chunkBytes);
+                for (size_t byteIdx = 0; byteIdx < len; ++byteIdx)
+                    buffer[pData[byteIdx] / 8] |= static_cast<uint8_t>(1 << pData[byteIdx] % 8);
+                return;
+            case container::runs:
+                memset(buffer, 0x00, s_chunkBytes);
+                for (size_t byteIdx = 0; byteIdx < len; byteIdx += 2)
+                    for (size_t bit = pData[byteIdx]; bit <= pData[byteIdx + 1]; ++bit)
+                        buffer[bit / 8] |= static_cast<uint8_t>(1 << bit % 8);
+                return;
+            default:
+                memset(buffer, 0x00, s_chunkBytes);
+                return;
+            }
+        }
+
+        // stores the chunk in the smallest container for its content
+        void encode(size_t chunk, const uint8_t(&buffer)[s_chunkBytes])
+        {
+            size_t setBits = 0;
+            size_t runCount = 0;
+            bool prevSet = false;
+            for (size_t bit = 0; bit < s_chunkBits; ++bit)
+            {
+                const bool curSet = (buffer[bit / 8] & (1 << bit % 8)) != 0;
+                setBits += curSet;
+                runCount += curSet && !prevSet;
+                prevSet = curSet;
+            }
+
+            uint8_t encoded[s_chunkBytes];
+            size_t len = 0;
+            container type;
+            if (setBits == 0)
+                type = container::empty;
+            else if (2 * runCount < setBits && 2 * runCount < s_chunkBytes)
+            {
+                type = container::runs;
+                for (size_t bit = 0; bit < s_chunkBits; ++bit)
+                {
+                    const bool curSet = (buffer[bit / 8] & (1 << bit % 8)) != 0;
+                    if (curSet && (bit == 0 || (buffer[(bit - 1) / 8] & (1 << (bit - 1) % 8)) == 0))
+                        encoded[len++] = static_cast<uint8_t>(bit);
+                    if (curSet && (bit == s_chunkBits - 1 || (buffer[(bit + 1) / 8] & (1 << (bit + 1) % 8)) == 0))
+                        encoded[len++] = static_cast<uint8_t>(bit);
+                }
+            }
+            else if (setBits < s_chunkBytes)
+            {
+                type = container::array;
+                for (size_t bit = 0; bit < s_chunkBits; ++bit)
+                    if ((buffer[bit / 8] & (1 << bit % 8)) != 0)
+                        encoded[len++] = static_cast<uint8_t>(bit);
+            }
+            else
+            {
+                type = container::bitmap;
+                memcpy(encoded, buffer, s_chunkBytes);
+                len = s_chunkBytes;
+            }
+
+            replace_chunk(chunk, type, encoded, len);
+        }
+
+        void replace_chunk(size_t chunk, container type, const uint8_t* pData, size_t len)
+        {
+            const size_t oldLen = chunk_bytes(chunk);
+            const size_t used = m_offsets[s_chunkCount];
+            verify(len <= oldLen || used + (len - oldLen) <= _poolBytes, "compressed_bitset pool exhausted");
+
+            auto* pChunk = m_pool + m_offsets[chunk];
+            if (len != oldLen)
+            {
+                memmove(pChunk + len, pChunk + oldLen, used - m_offsets[chunk + 1]);
+                for (size_t next = chunk + 1; next <= s_chunkCount; ++next)
+                    m_offsets[next] = static_cast<offset_type>(m_offsets[next] + len - oldLen);
+            }
+            memcpy(pChunk, pData, len);
+            m_types[chunk] = type;
+        }
+
+        template<size_t _otherPool, typename Op>
+        void combine(size_t chunk, const compressed_bitset<_size, _otherPool>& other, Op op)
+        {
+            uint8_t lhs[s_chunkBytes];
+            uint8_t rhs[s_chunkBytes];
+            decode(chunk, lhs);
+            other.decode(chunk, rhs);
+            for (size_t byteIdx = 0; byteIdx < s_chunkBytes; ++byteIdx)
+                lhs[byteIdx] = op(lhs[byteIdx], rhs[byteIdx]);
+            encode(chunk, lhs);
+        }
+
+        size_t find_from(size_t idx) const noexcept
+        {
+            for (auto chunk = idx / s_chunkBits; chunk < s_chunkCount; ++chunk)
+            {
+                if (m_types[chunk] != container::empty)
+                {
+                    uint8_t buffer[s_chunkBytes];
+                    decode(chunk, buffer);
+                    const auto first = chunk == idx / s_chunkBits ? idx % s_chunkBits : 0;
+                    for (auto bit = first; bit < s_chunkBits; ++bit)
+                        if (buffer[bit / 8] == 0)
+                            bit |= 7; // skip the rest of an empty byte
+                        else if ((buffer[bit / 8] & (1 << bit % 8)) != 0)
+                            return chunk * s_chunkBits + bit < _size ? chunk * s_chunkBits + bit : _size;
+                }
+            }
+            return _size;
+        }
+
+        container m_types[s_chunkCount];
+        offset_type m_offsets[s_chunkCount + 1];
+        uint8_t m_pool[_poolBytes];
+    };
+
+    // the result has the pool size of lhs
+    template<size_t _size, size_t _lhsPool, size_t _rhsPool>
+    [[nodiscard]] compressed_bitset<_size, _lhsPool> operator&(const compressed_bitset<_size, _lhsPool>& lhs, const compressed_bitset<_size, _rhsPool>& rhs)
+    {
+        auto ret = lhs;
+        return ret &= rhs;
+    }
+
+    template<size_t _size, size_t _lhsPool, size_t _rhsPool>
+    [[nodiscard]] compressed_bitset<_size, _lhsPool> operator|(const compressed_bitset<_size, _lhsPool>& lhs, const compressed_bitset<_size, _rhsPool>& rhs)
+    {
+        auto ret = lhs;
+        return ret |= rhs;
+    }
+
+    template<size_t _size, size_t _lhsPool, size_t _rhsPool>
+    [[nodiscard]] compressed_bitset<_size, _lhsPool> operator^(const compressed_bitset<_size, _lhsPool>& lhs, const compressed_bitset<_size, _rhsPool>& rhs)
+    {
+        auto ret = lhs;
+        return ret ^= rhs;
+    }
+}
+#endif // ASTD_COMPRESSED_BITSET
\ No newline at end of file
@@ -0,0 +1,298 @@
+#pragma once
+#ifndef ASTD_ENUM_SET
+#define ASTD_ENUM_SET
+#include "bitset.h"
+#include "type_traits.h"
+
+/*
+enum_set is not part of the STL. It is a set of enumerators of Enum whose values lie in [0, _max),
+stored as one bit per enumerator in the smallest unsigned type that holds _max bits (or an array of
+32 bit words above that). Everything is constexpr, so constant sets like capability masks are
+computed by the compiler and a check against them folds into a single masked compare.
+
+The enumerators are not range checked since that would rule out constant evaluation, passing a value
+>= _max is undefined.
+*/
+
+namespace astd
+{
+    template<typename Enum, size_t _max>
+    class enum_set
+    {
+        static_assert(_max > 0, "enum_set needs at least one enumerator");
+
+    private:
+        using word_type = conditional_t<_max <= 8, uint8_t, conditional_t<_max <= 16, uint16_t, uint32_t>>;
+
+    public:
+        using value_type = Enum;
+        using size_type = size_t;
+
+        class iterator
+        {
+            friend enum_set;
+
+        public:
+            [[nodiscard]] constexpr Enum operator*() const noexcept
+            {
+                return static_cast<Enum>(m_idx);
+            }
+
+            constexpr iterator& operator++() noexcept
+            {
+                m_idx = m_pSet->find_from(m_idx + 1);
+                return *this;
+            }
+
+            constexpr iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++*this;
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept
+            {
+                return m_idx == other.m_idx;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const noexcept
+            {
+                return m_idx != other.m_idx;
+            }
+
+        private:
+            constexpr iterator(const enum_set& set, size_t idx) noexcept
+                :m_pSet(&set), m_idx(idx)
+            {}
+
+            const enum_set* m_pSet;
+            size_t m_idx;
+        };
+
+        using const_iterator = iterator;
+
+        constexpr enum_set() noexcept
+            :m_data{}
+        {}
+
+        template<typename... Enums>
+        constexpr enum_set(Enum first, Enums... rest) noexcept
+            :m_data{}
+        {
+            insert(first);
+            (insert(rest), ...);
+        }
+
+        // the set of all enumerators in [0, _max)
+        [[nodiscard]] static constexpr enum_set full() noexcept
+        {
+            enum_set ret;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                ret.m_data[dataIdx] = dataIdx == s_arrSize - 1 ? s_trailMask : s_fullMask;
+            return ret;
+        }
+
+        [[nodiscard]] constexpr bool contains(Enum val) const noexcept
+        {
+            const auto idx = static_cast<size_t>(val);
+            return (m_data[idx / s_bitsInWord] & bit_mask(idx)) != 0;
+        }
+
+        constexpr enum_set& insert(Enum val) noexcept
+        {
+            const auto idx = static_cast<size_t>(val);
+            m_data[idx / s_bitsInWord] |= bit_mask(idx);
+            return *this;
+        }
+
+        constexpr enum_set& erase(Enum val) noexcept
+        {
+            const auto idx = static_cast<size_t>(val);
+            m_data[idx / s_bitsInWord] &= static_cast<word_type>(~bit_mask(idx));
+            return *this;
+        }
+
+        constexpr enum_set& toggle(Enum val) noexcept
+        {
+            const auto idx = static_cast<size_t>(val);
+            m_data[idx / s_bitsInWord] ^= bit_mask(idx);
+            return *this;
+        }
+
+        constexpr enum_set& clear() noexcept
+        {
+            for (auto& word : m_data)
+                word = 0;
+            return *this;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            for (const auto word : m_data)
+                if (word != 0)
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            size_type result = 0;
+            for (const auto word : m_data)
+                result += popcount(word);
+            return result;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return _max;
+        }
+
+        // true if every member of other is a member of this set
+        [[nodiscard]] constexpr bool includes(const enum_set& other) const noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                if ((m_data[dataIdx] & other.m_data[dataIdx]) != other.m_data[dataIdx])
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool intersects(const enum_set& other) const noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                if ((m_data[dataIdx] & other.m_data[dataIdx]) != 0)
+                    return true;
+
+            return false;
+        }
+
+        [[nodiscard]] constexpr bool operator==(const enum_set& other) const noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                if (m_data[dataIdx] != other.m_data[dataIdx])
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const enum_set& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        // union
+        constexpr enum_set& operator|=(const enum_set& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] |= other.m_data[dataIdx];
+            return *this;
+        }
+
+        // intersection
+        constexpr enum_set& operator&=(const enum_set& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] &= other.m_data[dataIdx];
+            return *this;
+        }
+
+        // symmetric difference
+        constexpr enum_set& operator^=(const enum_set& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] ^= other.m_data[dataIdx];
+            return *this;
+        }
+
+        // difference
+        constexpr enum_set& operator-=(const enum_set& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] &= static_cast<word_type>(~other.m_data[dataIdx]);
+            return *this;
+        }
+
+        // complement within [0, _max)
+        [[nodiscard]] constexpr enum_set operator~() const noexcept
+        {
+            auto ret = full();
+            ret -= *this;
+            return ret;
+        }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept
+        {
+            return iterator(*this, find_from(0));
+        }
+
+        [[nodiscard]] constexpr iterator end() const noexcept
+        {
+            return iterator(*this, _max);
+        }
+
+        [[nodiscard]] bitset<_max> to_bitset() const noexcept
+        {
+            bitset<_max> ret;
+            for (const auto val : *this)
+                ret[static_cast<size_t>(val)] = true;
+            return ret;
+        }
+
+    private:
+        static constexpr word_type bit_mask(size_t idx) noexcept
+        {
+            return static_cast<word_type>(static_cast<word_type>(1) << idx % s_bitsInWord);
+        }
+
+        constexpr size_t find_from(size_t idx) const noexcept
+        {
+            if (idx >= _max)
+                return _max;
+
+            auto dataIdx = idx / s_bitsInWord;
+            auto word = static_cast<word_type>(m_data[dataIdx] & (s_fullMask << idx % s_bitsInWord));
+            while (word == 0)
+            {
+                if (++dataIdx >= s_arrSize)
+                    return _max;
+                word = m_data[dataIdx];
+            }
+            return dataIdx * s_bitsInWord + countr_zero(word);
+        }
+
+        static constexpr size_t s_bitsInWord = 8 * sizeof(word_type);
+        static constexpr size_t s_arrSize = (_max - 1) / s_bitsInWord + 1;
+        static constexpr word_type s_fullMask = static_cast<word_type>(~static_cast<word_type>(0));
+        static constexpr word_type s_trailMask = _max % s_bitsInWord == 0 ? s_fullMask
+            : static_cast<word_type>((static_cast<word_type>(1) << _max % s_bitsInWord) - 1);
+
+        word_type m_data[s_arrSize];
+    };
+
+    template<typename Enum, size_t _max>
+    [[nodiscard]] constexpr enum_set<Enum, _max> operator|(enum_set<Enum, _max> lhs, const enum_set<Enum, _max>& rhs) noexcept
+    {
+        return lhs |= rhs;
+    }
+
+    template<typename Enum, size_t _max>
+    [[nodiscard]] constexpr enum_set<Enum, _max> operator&(enum_set<Enum, _max> lhs, const enum_set<Enum, _max>& rhs) noexcept
+    {
+        return lhs &= rhs;
+    }
+
+    template<typename Enum, size_t _max>
+    [[nodiscard]] constexpr enum_set<Enum, _max> operator^(enum_set<Enum, _max> lhs, const enum_set<Enum, _max>& rhs) noexcept
+    {
+        return lhs ^= rhs;
+    }
+
+    template<typename Enum, size_t _max>
+    [[nodiscard]] constexpr enum_set<Enum, _max> operator-(enum_set<Enum, _max> lhs, const enum_set<Enum, _max>& rhs) noexcept
+    {
+        return lhs -= rhs;
+    }
+}
+#endif // ASTD_ENUM_SET
\ No newline at end of file
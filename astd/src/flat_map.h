@@ -0,0 +1,508 @@
+#pragma once
+#ifndef ASTD_FLAT_MAP
+#define ASTD_FLAT_MAP
+#include "type_traits.h"
+#include "utility.h"
+#include "algorithm.h"
+#include "functional.h"
+#include "error.h"
+
+/*
+Mirrors std::flat_map and std::flat_set of C++23, but with a fixed capacity. The elements are kept
+sorted in an inline array, so a lookup is a binary search over contiguous memory and nothing is
+allocated. Inserting and erasing shift the elements behind the position and are O(N), which is fine
+for registries and routing tables that are mostly read.
+
+Built from an unsorted list the elements are copied and sorted once, of duplicate keys an unspecified
+one is kept. Input that is already sorted and unique can be passed with sorted_unique to skip the sort.
+Construction, lookup and insertion are constexpr, so read-only maps can be evaluated at compile time:
+
+    constexpr astd::flat_map<uint8_t, uint16_t, 3> timeouts({ { 7, 500 }, { 2, 100 }, { 4, 250 } });
+    static_assert(timeouts.at(4) == 250);
+
+If Compare declares is_transparent, like less<>, find / contains / count / lower_bound / upper_bound
+also accept other types comparable with the key, e.g. a const char* for a String key.
+
+Differences to std::flat_map / std::flat_set:
+The keys and values are stored as pair<K, V> in one array instead of two separate containers.
+No comparator object is stored, so Compare has to be default constructible.
+All elements of the array are default constructed, removed ones are reset to a default constructed
+value. Exceeding the capacity is reported through verify.
+The size is stored in a uint8_t if _capacity fits into one.
+*/
+
+namespace astd
+{
+    struct sorted_unique_t
+    {
+        explicit sorted_unique_t() = default;
+    };
+
+    constexpr sorted_unique_t sorted_unique{};
+
+    template<typename, typename C>
+    struct _is_transparent_impl : false_type
+    {};
+
+    template<typename C>
+    struct _is_transparent_impl<void_t<typename C::is_transparent>, C> : true_type
+    {};
+
+    template<typename C>
+    constexpr bool _is_transparent_v = _is_transparent_impl<void_t<>, C>::value;
+
+    struct _flat_map_key_of
+    {
+        template<typename T>
+        [[nodiscard]] static constexpr const auto& get(const T& val) noexcept
+        {
+            return val.first;
+        }
+    };
+
+    struct _flat_set_key_of
+    {
+        template<typename T>
+        [[nodiscard]] static constexpr const T& get(const T& val) noexcept
+        {
+            return val;
+        }
+    };
+
+    // the sorted storage shared by flat_map and flat_set
+    template<typename T, typename Key, size_t _capacity, typename Compare, typename KeyOf>
+    class _flat_container
+    {
+        static_assert(_capacity > 0, "flat containers need a capacity of at least one");
+
+    protected:
+        using stored_size_type = conditional_t<_capacity <= 0xFF, uint8_t, size_t>;
+
+    public:
+        using key_type = Key;
+        using value_type = T;
+        using key_compare = Compare;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        struct value_compare
+        {
+            [[nodiscard]] constexpr bool operator()(const T& lhs, const T& rhs) const
+            {
+                return Compare()(KeyOf::get(lhs), KeyOf::get(rhs));
+            }
+        };
+
+        constexpr _flat_container() noexcept
+            :m_data(), m_size(0)
+        {}
+
+        template<size_t _count>
+        constexpr _flat_container(const T(&init)[_count])
+            :m_data(), m_size(_count)
+        {
+            static_assert(_count <= _capacity, "too many elements for the capacity");
+            for (size_t idx = 0; idx < _count; ++idx)
+                m_data[idx] = init[idx];
+            sort_unique();
+        }
+
+        // init has to be sorted and free of duplicates
+        template<size_t _count>
+        constexpr _flat_container(sorted_unique_t, const T(&init)[_count])
+            :m_data(), m_size(_count)
+        {
+            static_assert(_count <= _capacity, "too many elements for the capacity");
+            for (size_t idx = 0; idx < _count; ++idx)
+                m_data[idx] = init[idx];
+#if _DEBUG
+            // only calls verify on failure, so the check does not prevent constant evaluation
+            for (size_t idx = 1; idx < _count; ++idx)
+                if (!value_compare()(m_data[idx - 1], m_data[idx]))
+                    verify(false, "sorted_unique input is not sorted and unique");
+#endif
+        }
+
+        template<typename InputIt>
+        constexpr _flat_container(InputIt first, InputIt last)
+            :m_data(), m_size(0)
+        {
+            for (; first != last; ++first)
+            {
+                if (m_size == _capacity)
+                    verify(false, "flat container capacity exceeded");
+                m_data[m_size++] = *first;
+            }
+            sort_unique();
+        }
+
+        [[nodiscard]] constexpr iterator begin() noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr const_iterator begin() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr iterator end() noexcept
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] constexpr const_iterator end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] constexpr const_iterator cbegin() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr const_iterator cend() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return _capacity;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr bool full() const noexcept
+        {
+            return m_size == _capacity;
+        }
+
+        [[nodiscard]] constexpr key_compare key_comp() const noexcept
+        {
+            return key_compare();
+        }
+
+        [[nodiscard]] constexpr value_compare value_comp() const noexcept
+        {
+            return value_compare();
+        }
+
+        constexpr void clear()
+        {
+            for (size_t idx = 0; idx < m_size; ++idx)
+                m_data[idx] = T();
+            m_size = 0;
+        }
+
+        constexpr pair<iterator, bool> insert(const T& val)
+        {
+            return insert_unique(val);
+        }
+
+        constexpr pair<iterator, bool> insert(T&& val)
+        {
+            return insert_unique(astd::move(val));
+        }
+
+        // inserts all elements and sorts once, instead of shifting per element
+        template<typename InputIt>
+        constexpr void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                if (m_size == _capacity)
+                    verify(false, "flat container capacity exceeded");
+                m_data[m_size++] = *first;
+            }
+            sort_unique();
+        }
+
+        constexpr iterator erase(const_iterator pos)
+        {
+            const auto it = begin() + (pos - cbegin());
+            astd::move(it + 1, end(), it);
+            m_data[--m_size] = T();
+            return it;
+        }
+
+        constexpr size_type erase(const key_type& key)
+        {
+            const auto it = find(key);
+            if (it == end())
+                return 0;
+
+            erase(it);
+            return 1;
+        }
+
+        [[nodiscard]] constexpr iterator find(const key_type& key)
+        {
+            return m_data + find_idx(key);
+        }
+
+        [[nodiscard]] constexpr const_iterator find(const key_type& key) const
+        {
+            return m_data + find_idx(key);
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr iterator find(const K2& key)
+        {
+            return m_data + find_idx(key);
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr const_iterator find(const K2& key) const
+        {
+            return m_data + find_idx(key);
+        }
+
+        [[nodiscard]] constexpr bool contains(const key_type& key) const
+        {
+            return find_idx(key) != m_size;
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr bool contains(const K2& key) const
+        {
+            return find_idx(key) != m_size;
+        }
+
+        [[nodiscard]] constexpr size_type count(const key_type& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr size_type count(const K2& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        [[nodiscard]] constexpr iterator lower_bound(const key_type& key)
+        {
+            return m_data + lower_bound_idx(key);
+        }
+
+        [[nodiscard]] constexpr const_iterator lower_bound(const key_type& key) const
+        {
+            return m_data + lower_bound_idx(key);
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr iterator lower_bound(const K2& key)
+        {
+            return m_data + lower_bound_idx(key);
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr const_iterator lower_bound(const K2& key) const
+        {
+            return m_data + lower_bound_idx(key);
+        }
+
+        [[nodiscard]] constexpr iterator upper_bound(const key_type& key)
+        {
+            return m_data + upper_bound_idx(key);
+        }
+
+        [[nodiscard]] constexpr const_iterator upper_bound(const key_type& key) const
+        {
+            return m_data + upper_bound_idx(key);
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr iterator upper_bound(const K2& key)
+        {
+            return m_data + upper_bound_idx(key);
+        }
+
+        template<typename K2, typename C = Compare, enable_if_t<_is_transparent_v<C>, int> = 0>
+        [[nodiscard]] constexpr const_iterator upper_bound(const K2& key) const
+        {
+            return m_data + upper_bound_idx(key);
+        }
+
+        [[nodiscard]] constexpr bool operator==(const _flat_container& other) const
+        {
+            if (m_size != other.m_size)
+                return false;
+
+            for (size_t idx = 0; idx < m_size; ++idx)
+                if (!(m_data[idx] == other.m_data[idx]))
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool operator!=(const _flat_container& other) const
+        {
+            return !(*this == other);
+        }
+
+    protected:
+        template<typename K2>
+        [[nodiscard]] constexpr size_t lower_bound_idx(const K2& key) const
+        {
+            const auto it = astd::lower_bound(m_data, m_data + m_size, key,
+                [](const T& val, const K2& k) { return Compare()(KeyOf::get(val), k); });
+            return static_cast<size_t>(it - m_data);
+        }
+
+        template<typename K2>
+        [[nodiscard]] constexpr size_t upper_bound_idx(const K2& key) const
+        {
+            const auto it = astd::upper_bound(m_data, m_data + m_size, key,
+                [](const K2& k, const T& val) { return Compare()(k, KeyOf::get(val)); });
+            return static_cast<size_t>(it - m_data);
+        }
+
+        // m_size if key is not contained
+        template<typename K2>
+        [[nodiscard]] constexpr size_t find_idx(const K2& key) const
+        {
+            const auto idx = lower_bound_idx(key);
+            return is_key_at(idx, key) ? idx : m_size;
+        }
+
+        // true if key is equivalent to the one of the element at idx
+        template<typename K2>
+        [[nodiscard]] constexpr bool is_key_at(size_t idx, const K2& key) const
+        {
+            return idx != m_size && !Compare()(key, KeyOf::get(m_data[idx]));
+        }
+
+        template<typename U>
+        constexpr iterator insert_at(size_t idx, U&& val)
+        {
+            // verify only on failure, so that inserting stays usable in constant expressions
+            if (m_size == _capacity)
+                verify(false, "flat container capacity exceeded");
+            astd::move_backward(m_data + idx, m_data + m_size, m_data + m_size + 1);
+            m_data[idx] = forward<U>(val);
+            ++m_size;
+            return m_data + idx;
+        }
+
+        template<typename U>
+        constexpr pair<iterator, bool> insert_unique(U&& val)
+        {
+            const auto idx = lower_bound_idx(KeyOf::get(val));
+            if (is_key_at(idx, KeyOf::get(val)))
+                return pair<iterator, bool>(m_data + idx, false);
+
+            return pair<iterator, bool>(insert_at(idx, forward<U>(val)), true);
+        }
+
+        constexpr void sort_unique()
+        {
+            if (m_size == 0)
+                return;
+
+            value_compare comp;
+            astd::sort(m_data, m_data + m_size, comp);
+
+            size_t last = 0;
+            for (size_t idx = 1; idx < m_size; ++idx)
+            {
+                if (comp(m_data[last], m_data[idx]) && ++last != idx)
+                    m_data[last] = astd::move(m_data[idx]);
+            }
+
+            for (size_t idx = last + 1; idx < m_size; ++idx)
+                m_data[idx] = T();
+            m_size = static_cast<stored_size_type>(last + 1);
+        }
+
+        T m_data[_capacity];
+        stored_size_type m_size;
+    };
+
+    template<typename K, typename V, size_t _capacity, typename Compare = less<K>>
+    class flat_map : public _flat_container<pair<K, V>, K, _capacity, Compare, _flat_map_key_of>
+    {
+        using base = _flat_container<pair<K, V>, K, _capacity, Compare, _flat_map_key_of>;
+
+    public:
+        using mapped_type = V;
+        using typename base::key_type;
+        using typename base::value_type;
+        using typename base::iterator;
+        using typename base::const_iterator;
+
+        using base::base;
+
+        [[nodiscard]] constexpr V& at(const key_type& key)
+        {
+            const auto idx = this->find_idx(key);
+            if (idx == this->m_size)
+                verify(false, "flat_map key not found");
+            return this->m_data[idx].second;
+        }
+
+        [[nodiscard]] constexpr const V& at(const key_type& key) const
+        {
+            const auto idx = this->find_idx(key);
+            if (idx == this->m_size)
+                verify(false, "flat_map key not found");
+            return this->m_data[idx].second;
+        }
+
+        // inserts a default constructed value if key is not contained
+        constexpr V& operator[](const key_type& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        // constructs the value from args only if key is not contained yet
+        template<typename... Args>
+        constexpr pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            const auto idx = this->lower_bound_idx(key);
+            if (this->is_key_at(idx, key))
+                return pair<iterator, bool>(this->m_data + idx, false);
+
+            return pair<iterator, bool>(this->insert_at(idx, value_type(key, V(forward<Args>(args)...))), true);
+        }
+
+        template<typename M>
+        constexpr pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+        {
+            const auto idx = this->lower_bound_idx(key);
+            if (this->is_key_at(idx, key))
+            {
+                this->m_data[idx].second = forward<M>(obj);
+                return pair<iterator, bool>(this->m_data + idx, false);
+            }
+
+            return pair<iterator, bool>(this->insert_at(idx, value_type(key, forward<M>(obj))), true);
+        }
+    };
+
+    template<typename K, size_t _capacity, typename Compare = less<K>>
+    class flat_set : public _flat_container<K, K, _capacity, Compare, _flat_set_key_of>
+    {
+        using base = _flat_container<K, K, _capacity, Compare, _flat_set_key_of>;
+
+    public:
+        using base::base;
+    };
+}
+#endif // ASTD_FLAT_MAP
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "type_traits.h"
 #include "memory.h"
+#include "WString.h" // using the avr String class
 
 namespace astd
 {
@@ -16,6 +17,19 @@ namespace astd
         }
     };
 
+    // transparent, compares arguments of any two types
+    template<>
+    struct less<void>
+    {
+        using is_transparent = void;
+
+        template<typename T, typename U>
+        constexpr bool operator()(T&& lhs, U&& rhs) const
+        {
+            return forward<T>(lhs) < forward<U>(rhs);
+        }
+    };
+
     template<typename T = void>
     struct greater
     {
@@ -25,6 +39,19 @@ namespace astd
         }
     };
 
+    // transparent, compares arguments of any two types
+    template<>
+    struct greater<void>
+    {
+        using is_transparent = void;
+
+        template<typename T, typename U>
+        constexpr bool operator()(T&& lhs, U&& rhs) const
+        {
+            return forward<T>(lhs) > forward<U>(rhs);
+        }
+    };
+
     template<typename T = void>
     struct less_equal
     {
@@ -34,6 +61,19 @@ namespace astd
         }
     };
 
+    // transparent, compares arguments of any two types
+    template<>
+    struct less_equal<void>
+    {
+        using is_transparent = void;
+
+        template<typename T, typename U>
+        constexpr bool operator()(T&& lhs, U&& rhs) const
+        {
+            return forward<T>(lhs) <= forward<U>(rhs);
+        }
+    };
+
     template<typename T = void>
     struct greater_equal
     {
@@ -43,6 +83,124 @@ namespace astd
         }
     };
 
+    // transparent, compares arguments of any two types
+    template<>
+    struct greater_equal<void>
+    {
+        using is_transparent = void;
+
+        template<typename T, typename U>
+        constexpr bool operator()(T&& lhs, U&& rhs) const
+        {
+            return forward<T>(lhs) >= forward<U>(rhs);
+        }
+    };
+
+    template<typename T = void>
+    struct equal_to
+    {
+        constexpr bool operator()(const T& lhs, const T& rhs) const
+        {
+            return lhs == rhs;
+        }
+    };
+
+    // transparent, compares arguments of any two types
+    template<>
+    struct equal_to<void>
+    {
+        using is_transparent = void;
+
+        template<typename T, typename U>
+        constexpr bool operator()(T&& lhs, U&& rhs) const
+        {
+            return forward<T>(lhs) == forward<U>(rhs);
+        }
+    };
+
+    /*
+    hash mirrors std::hash for integral, enum and pointer types as well as String. The integer hashes
+    are the value itself folded into a size_t, the hash tables spread them with a multiplicative mix.
+    Byte strings are hashed with 32 bit FNV-1a, folded on 16 bit targets.
+    */
+    template<typename Char>
+    [[nodiscard]] constexpr size_t _hash_bytes(const Char* pData, size_t count) noexcept
+    {
+        static_assert(sizeof(Char) == 1, "_hash_bytes needs a byte sized type");
+        uint32_t hash = 2166136261UL;
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            hash ^= static_cast<uint8_t>(pData[idx]);
+            hash *= 16777619UL;
+        }
+
+        if constexpr (sizeof(size_t) < sizeof(uint32_t))
+            return static_cast<size_t>(hash ^ (hash >> 16));
+        else
+            return static_cast<size_t>(hash);
+    }
+
+    template<typename T, typename = void>
+    struct _hash_impl
+    {};
+
+    template<typename T>
+    struct _hash_impl<T, enable_if_t<is_integral_v<T> || is_enum_v<T>>>
+    {
+        [[nodiscard]] constexpr size_t operator()(T val) const noexcept
+        {
+            if constexpr (sizeof(T) <= sizeof(size_t))
+                return static_cast<size_t>(val);
+            else
+            {
+                auto bits = static_cast<unsigned long long>(val);
+                auto hash = static_cast<size_t>(bits);
+                for (size_t shift = sizeof(size_t) * 8; shift < sizeof(T) * 8; shift += sizeof(size_t) * 8)
+                    hash ^= static_cast<size_t>(bits >> shift);
+                return hash;
+            }
+        }
+    };
+
+    template<typename T>
+    struct _hash_impl<T*>
+    {
+        [[nodiscard]] size_t operator()(T* ptr) const noexcept
+        {
+            return reinterpret_cast<size_t>(ptr);
+        }
+    };
+
+    template<typename T>
+    struct hash : _hash_impl<T>
+    {};
+
+    template<>
+    struct hash<String>
+    {
+        [[nodiscard]] size_t operator()(const String& str) const noexcept
+        {
+            return _hash_bytes(str.c_str(), str.length());
+        }
+    };
+
+    // hash and equality of the characters of C strings instead of their addresses, e.g. for string literal keys
+    struct c_str_hash
+    {
+        [[nodiscard]] size_t operator()(const char* str) const noexcept
+        {
+            return _hash_bytes(str, strlen(str));
+        }
+    };
+
+    struct c_str_equal
+    {
+        [[nodiscard]] bool operator()(const char* lhs, const char* rhs) const noexcept
+        {
+            return strcmp(lhs, rhs) == 0;
+        }
+    };
+
     template<typename return_type, typename... Args>
     class invocable_base
     {
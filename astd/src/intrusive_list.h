@@ -0,0 +1,443 @@
+#pragma once
+#ifndef ASTD_INTRUSIVE_LIST
+#define ASTD_INTRUSIVE_LIST
+#include "type_traits.h"
+#include "error.h"
+
+/*
+intrusive_list is not part of the STL (it mirrors boost::intrusive::list). It is a doubly linked list
+whose links live inside the elements, in a hook member, so linking never allocates. The list does not
+own its elements, it only links objects that live elsewhere, e.g. statically allocated requests that
+move from a driver's pending queue to its done queue:
+
+    struct request
+    {
+        uint8_t m_cmd;
+        astd::intrusive_list_hook m_hook;
+    };
+
+    astd::intrusive_list<request, &request::m_hook> pending;
+
+Insertion, erasing an element by reference and all splices are O(1). Therefore the list does not
+count its elements, size() walks the list.
+
+An element can be in one list per hook at a time, inserting a linked element is reported through
+verify. Elements must be erased before they are destroyed, unless their hook is an
+intrusive_list_auto_unlink_hook, which unlinks itself in its destructor. Copying an element does not
+copy its membership, the copy starts unlinked.
+*/
+
+namespace astd
+{
+    class _intrusive_list_node
+    {
+    public:
+        constexpr _intrusive_list_node() noexcept
+            :m_pPrev(nullptr), m_pNext(nullptr)
+        {}
+
+        _intrusive_list_node* m_pPrev;
+        _intrusive_list_node* m_pNext;
+    };
+
+    class intrusive_list_hook : public _intrusive_list_node
+    {
+    public:
+        constexpr intrusive_list_hook() noexcept = default;
+
+        constexpr intrusive_list_hook(const intrusive_list_hook&) noexcept
+            :_intrusive_list_node()
+        {}
+
+        // keeps the membership of the assigned to element
+        constexpr intrusive_list_hook& operator=(const intrusive_list_hook&) noexcept
+        {
+            return *this;
+        }
+
+        ~intrusive_list_hook()
+        {
+#if _DEBUG
+            verify(!is_linked(), "linked element of an intrusive_list destroyed");
+#endif
+        }
+
+        [[nodiscard]] constexpr bool is_linked() const noexcept
+        {
+            return m_pNext != nullptr;
+        }
+
+    protected:
+        void unlink_self() noexcept
+        {
+            m_pPrev->m_pNext = m_pNext;
+            m_pNext->m_pPrev = m_pPrev;
+            m_pPrev = nullptr;
+            m_pNext = nullptr;
+        }
+    };
+
+    class intrusive_list_auto_unlink_hook : public intrusive_list_hook
+    {
+    public:
+        constexpr intrusive_list_auto_unlink_hook() noexcept = default;
+        constexpr intrusive_list_auto_unlink_hook(const intrusive_list_auto_unlink_hook&) noexcept = default;
+        constexpr intrusive_list_auto_unlink_hook& operator=(const intrusive_list_auto_unlink_hook&) noexcept = default;
+
+        ~intrusive_list_auto_unlink_hook()
+        {
+            unlink();
+        }
+
+        // removes the element from whichever list it is in
+        void unlink() noexcept
+        {
+            if (is_linked())
+                unlink_self();
+        }
+    };
+
+    template<typename T, auto _hook>
+    class intrusive_list
+    {
+        using hook_type = remove_reference_t<decltype(declval<T&>().*_hook)>;
+        using node = _intrusive_list_node;
+
+        static_assert(is_same_v<hook_type, intrusive_list_hook> || is_same_v<hook_type, intrusive_list_auto_unlink_hook>,
+            "the hook of an intrusive_list has to be an intrusive_list_hook or intrusive_list_auto_unlink_hook member");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using reference = T&;
+        using const_reference = const T&;
+
+        template<bool _is_const>
+        class _iterator
+        {
+            using node_pointer = conditional_t<_is_const, const node*, node*>;
+
+        public:
+            using value_type = T;
+            using difference_type = ptrdiff_t;
+            using reference = conditional_t<_is_const, const T&, T&>;
+            using pointer = conditional_t<_is_const, const T*, T*>;
+
+            constexpr _iterator() noexcept
+                :m_pNode(nullptr)
+            {}
+
+            constexpr explicit _iterator(node_pointer pNode) noexcept
+                :m_pNode(pNode)
+            {}
+
+            // iterator to const_iterator
+            template<bool _other_const, enable_if_t<_is_const && !_other_const, int> = 0>
+            constexpr _iterator(const _iterator<_other_const>& other) noexcept
+                :m_pNode(other.m_pNode)
+            {}
+
+            [[nodiscard]] reference operator*() const noexcept
+            {
+                return *to_value(m_pNode);
+            }
+
+            [[nodiscard]] pointer operator->() const noexcept
+            {
+                return to_value(m_pNode);
+            }
+
+            _iterator& operator++() noexcept
+            {
+                m_pNode = m_pNode->m_pNext;
+                return *this;
+            }
+
+            _iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                m_pNode = m_pNode->m_pNext;
+                return ret;
+            }
+
+            _iterator& operator--() noexcept
+            {
+                m_pNode = m_pNode->m_pPrev;
+                return *this;
+            }
+
+            _iterator operator--(int) noexcept
+            {
+                auto ret = *this;
+                m_pNode = m_pNode->m_pPrev;
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const _iterator& other) const noexcept
+            {
+                return m_pNode == other.m_pNode;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const _iterator& other) const noexcept
+            {
+                return m_pNode != other.m_pNode;
+            }
+
+        private:
+            friend class intrusive_list;
+            friend class _iterator<!_is_const>;
+
+            node_pointer m_pNode;
+        };
+
+        using iterator = _iterator<false>;
+        using const_iterator = _iterator<true>;
+
+        intrusive_list() noexcept
+        {
+            m_head.m_pPrev = &m_head;
+            m_head.m_pNext = &m_head;
+        }
+
+        intrusive_list(const intrusive_list&) = delete;
+        intrusive_list& operator=(const intrusive_list&) = delete;
+
+        intrusive_list(intrusive_list&& other) noexcept
+            :intrusive_list()
+        {
+            splice(end(), other);
+        }
+
+        intrusive_list& operator=(intrusive_list&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                splice(end(), other);
+            }
+            return *this;
+        }
+
+        ~intrusive_list()
+        {
+            clear();
+        }
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+            return iterator(m_head.m_pNext);
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator(m_head.m_pNext);
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return iterator(&m_head);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator(&m_head);
+        }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        [[nodiscard]] const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_head.m_pNext == &m_head;
+        }
+
+        // O(N), the list does not count its elements
+        [[nodiscard]] size_type size() const noexcept
+        {
+            size_type count = 0;
+            for (auto pNode = m_head.m_pNext; pNode != &m_head; pNode = pNode->m_pNext)
+                ++count;
+            return count;
+        }
+
+        [[nodiscard]] T& front() noexcept
+        {
+            return *to_value(m_head.m_pNext);
+        }
+
+        [[nodiscard]] const T& front() const noexcept
+        {
+            return *to_value(m_head.m_pNext);
+        }
+
+        [[nodiscard]] T& back() noexcept
+        {
+            return *to_value(m_head.m_pPrev);
+        }
+
+        [[nodiscard]] const T& back() const noexcept
+        {
+            return *to_value(m_head.m_pPrev);
+        }
+
+        // the iterator of an element of this list
+        [[nodiscard]] static iterator iterator_to(T& val) noexcept
+        {
+            return iterator(&(val.*_hook));
+        }
+
+        [[nodiscard]] static const_iterator iterator_to(const T& val) noexcept
+        {
+            return const_iterator(&(val.*_hook));
+        }
+
+        void push_front(T& val)
+        {
+            insert(begin(), val);
+        }
+
+        void push_back(T& val)
+        {
+            insert(end(), val);
+        }
+
+        void pop_front()
+        {
+            verify(!empty(), "intrusive_list::pop_front on empty list");
+            erase(begin());
+        }
+
+        void pop_back()
+        {
+            verify(!empty(), "intrusive_list::pop_back on empty list");
+            erase(const_iterator(m_head.m_pPrev));
+        }
+
+        // links val before pos
+        iterator insert(const_iterator pos, T& val)
+        {
+            node* pNode = &(val.*_hook);
+            verify(pNode->m_pNext == nullptr, "element is already linked into an intrusive_list");
+
+            node* pNext = const_cast<node*>(pos.m_pNode);
+            link_before(pNext, pNode, pNode);
+            return iterator(pNode);
+        }
+
+        // unlinks the element at pos, returns the iterator behind it
+        iterator erase(const_iterator pos) noexcept
+        {
+            node* pNode = const_cast<node*>(pos.m_pNode);
+            node* pNext = pNode->m_pNext;
+            pNode->m_pPrev->m_pNext = pNext;
+            pNext->m_pPrev = pNode->m_pPrev;
+            pNode->m_pPrev = nullptr;
+            pNode->m_pNext = nullptr;
+            return iterator(pNext);
+        }
+
+        // unlinks val, which has to be an element of this list
+        void erase(T& val) noexcept
+        {
+            erase(iterator_to(val));
+        }
+
+        iterator erase(const_iterator first, const_iterator last) noexcept
+        {
+            while (first != last)
+                first = erase(first);
+            return iterator(const_cast<node*>(last.m_pNode));
+        }
+
+        // unlinks all elements, O(N) since every hook is reset
+        void clear() noexcept
+        {
+            auto pNode = m_head.m_pNext;
+            while (pNode != &m_head)
+            {
+                auto pNext = pNode->m_pNext;
+                pNode->m_pPrev = nullptr;
+                pNode->m_pNext = nullptr;
+                pNode = pNext;
+            }
+            m_head.m_pPrev = &m_head;
+            m_head.m_pNext = &m_head;
+        }
+
+        // moves all elements of other before pos
+        void splice(const_iterator pos, intrusive_list& other) noexcept
+        {
+            splice(pos, other, other.begin(), other.end());
+        }
+
+        // moves the element at it of other before pos
+        void splice(const_iterator pos, intrusive_list& other, const_iterator it) noexcept
+        {
+            auto last = it;
+            ++last;
+            // the element is already in place, linking it before itself would close it into a loop
+            if (pos == it || pos == last)
+                return;
+
+            splice(pos, other, it, last);
+        }
+
+        // moves [first, last) of other before pos, pos must not be inside the range
+        void splice(const_iterator pos, intrusive_list&, const_iterator first, const_iterator last) noexcept
+        {
+            if (first == last || pos == last)
+                return;
+#if _DEBUG
+            verify(pos != first, "intrusive_list::splice position inside the spliced range");
+#endif
+
+            node* pFirst = const_cast<node*>(first.m_pNode);
+            node* pLast = last.m_pNode->m_pPrev;
+
+            pFirst->m_pPrev->m_pNext = const_cast<node*>(last.m_pNode);
+            const_cast<node*>(last.m_pNode)->m_pPrev = pFirst->m_pPrev;
+
+            link_before(const_cast<node*>(pos.m_pNode), pFirst, pLast);
+        }
+
+    private:
+        // links the chain [pFirst, pLast] before pNext
+        static void link_before(node* pNext, node* pFirst, node* pLast) noexcept
+        {
+            node* pPrev = pNext->m_pPrev;
+            pPrev->m_pNext = pFirst;
+            pFirst->m_pPrev = pPrev;
+            pLast->m_pNext = pNext;
+            pNext->m_pPrev = pLast;
+        }
+
+        // the element containing the hook pNode, the offset of the hook is folded by the compiler
+        [[nodiscard]] static T* to_value(node* pNode) noexcept
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(static_cast<hook_type*>(pNode)) - hook_offset());
+        }
+
+        [[nodiscard]] static const T* to_value(const node* pNode) noexcept
+        {
+            return to_value(const_cast<node*>(pNode));
+        }
+
+        // only the address of the buffer is used, so it is optimized away
+        [[nodiscard]] static size_t hook_offset() noexcept
+        {
+            alignas(T) unsigned char dummy[sizeof(T)];
+            const auto* pDummy = reinterpret_cast<const T*>(dummy);
+            return static_cast<size_t>(reinterpret_cast<const unsigned char*>(&(pDummy->*_hook)) - dummy);
+        }
+
+        node m_head;
+    };
+}
+#endif // ASTD_INTRUSIVE_LIST
\ No newline at end of file
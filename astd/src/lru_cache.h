@@ -0,0 +1,267 @@
+#pragma once
+#ifndef ASTD_LRU_CACHE
+#define ASTD_LRU_CACHE
+#include "type_traits.h"
+#include "utility.h"
+#include "array.h"
+#include "functional.h"
+#include "static_unordered_map.h"
+#include "error.h"
+
+/*
+lru_cache is not part of the STL. It keeps the last _capacity entries of an expensive lookup, e.g.
+calibration records decoded from EEPROM or read over I2C, and evicts the least recently used entry
+when a new one does not fit anymore.
+
+The entries live in an array, their recency order in a doubly linked list of indices next to it, with
+uint8_t links up to 255 entries (indices 0..254, 0xFF marks the end) and uint16_t links above. A
+static_unordered_map with at least twice as many slots as entries maps the keys to their indices. So
+hits, misses and evictions are all O(1) and nothing is allocated.
+
+get marks an entry as most recently used and counts a hit or a miss, peek and contains do neither.
+The counters saturate instead of wrapping around.
+*/
+
+namespace astd
+{
+    template<typename K, typename V, size_t _capacity, typename Hash = hash<K>, typename KeyEqual = equal_to<K>>
+    class lru_cache
+    {
+        static_assert(_capacity > 0 && _capacity < 0xFFFF, "lru_cache needs a capacity between 1 and 65534");
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = pair<K, V>;
+        using size_type = size_t;
+        using index_type = conditional_t<_capacity <= 0xFF, uint8_t, uint16_t>;
+
+    private:
+        static constexpr index_type s_npos = static_cast<index_type>(-1);
+
+        [[nodiscard]] static constexpr size_t index_slots() noexcept
+        {
+            size_t slots = 1;
+            while (slots < 2 * _capacity)
+                slots <<= 1;
+            return slots;
+        }
+
+        struct link
+        {
+            index_type prev;
+            index_type next;
+        };
+
+    public:
+        lru_cache() noexcept
+        {
+            clear();
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr bool full() const noexcept
+        {
+            return m_size == _capacity;
+        }
+
+        [[nodiscard]] constexpr uint32_t hits() const noexcept
+        {
+            return m_hits;
+        }
+
+        [[nodiscard]] constexpr uint32_t misses() const noexcept
+        {
+            return m_misses;
+        }
+
+        void reset_stats() noexcept
+        {
+            m_hits = 0;
+            m_misses = 0;
+        }
+
+        void clear()
+        {
+            m_index.clear();
+            for (size_t idx = 0; idx < _capacity; ++idx)
+            {
+                m_entries[idx] = value_type();
+                m_links[idx].prev = s_npos;
+                m_links[idx].next = idx + 1 < _capacity ? static_cast<index_type>(idx + 1) : s_npos;
+            }
+            m_head = s_npos;
+            m_tail = s_npos;
+            m_free = 0;
+            m_size = 0;
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return m_index.contains(key);
+        }
+
+        // the cached value without changing the recency order or the counters, nullptr if not cached
+        [[nodiscard]] const V* peek(const key_type& key) const
+        {
+            const auto it = m_index.find(key);
+            return it != m_index.end() ? &m_entries[it->second].second : nullptr;
+        }
+
+        // the cached value and marks it as most recently used, nullptr if not cached
+        [[nodiscard]] V* get(const key_type& key)
+        {
+            const auto it = m_index.find(key);
+            if (it == m_index.end())
+            {
+                count(m_misses);
+                return nullptr;
+            }
+
+            count(m_hits);
+            move_to_front(it->second);
+            return &m_entries[it->second].second;
+        }
+
+        // returns the cached value or stores and returns load(key) on a miss, e.g. a read from EEPROM
+        template<typename Loader>
+        V& get_or_load(const key_type& key, Loader&& load)
+        {
+            if (auto* pVal = get(key))
+                return *pVal;
+
+            return m_entries[insert_new(key, load(key))].second;
+        }
+
+        // inserts or assigns the value of key and marks it as most recently used, evicts if full
+        template<typename M>
+        V& put(const key_type& key, M&& val)
+        {
+            const auto it = m_index.find(key);
+            if (it != m_index.end())
+            {
+                move_to_front(it->second);
+                auto& entry = m_entries[it->second];
+                entry.second = forward<M>(val);
+                return entry.second;
+            }
+
+            return m_entries[insert_new(key, forward<M>(val))].second;
+        }
+
+        bool erase(const key_type& key)
+        {
+            const auto it = m_index.find(key);
+            if (it == m_index.end())
+                return false;
+
+            const auto idx = it->second;
+            m_index.erase(it);
+            unlink(idx);
+            m_entries[idx] = value_type();
+            m_links[idx].next = m_free;
+            m_free = idx;
+            --m_size;
+            return true;
+        }
+
+        // the key of the entry evicted next, the cache must not be empty
+        [[nodiscard]] const key_type& lru_key() const
+        {
+            verify(m_tail != s_npos, "lru_cache is empty");
+            return m_entries[m_tail].first;
+        }
+
+    private:
+        static void count(uint32_t& counter) noexcept
+        {
+            if (counter != static_cast<uint32_t>(-1))
+                ++counter;
+        }
+
+        void unlink(index_type idx) noexcept
+        {
+            const auto prev = m_links[idx].prev;
+            const auto next = m_links[idx].next;
+            if (prev != s_npos)
+                m_links[prev].next = next;
+            else
+                m_head = next;
+
+            if (next != s_npos)
+                m_links[next].prev = prev;
+            else
+                m_tail = prev;
+        }
+
+        void push_front(index_type idx) noexcept
+        {
+            m_links[idx].prev = s_npos;
+            m_links[idx].next = m_head;
+            if (m_head != s_npos)
+                m_links[m_head].prev = idx;
+            else
+                m_tail = idx;
+            m_head = idx;
+        }
+
+        void move_to_front(index_type idx) noexcept
+        {
+            if (idx == m_head)
+                return;
+
+            unlink(idx);
+            push_front(idx);
+        }
+
+        // key must not be cached yet, returns the index of the new entry
+        template<typename M>
+        index_type insert_new(const key_type& key, M&& val)
+        {
+            index_type idx = m_free;
+            if (idx != s_npos)
+            {
+                m_free = m_links[idx].next;
+                ++m_size;
+            }
+            else
+            {
+                // evict the least recently used entry and reuse its place
+                idx = m_tail;
+                m_index.erase(m_entries[idx].first);
+                unlink(idx);
+            }
+
+            m_entries[idx].first = key;
+            m_entries[idx].second = forward<M>(val);
+            m_index.insert(pair<K, index_type>(key, idx));
+            push_front(idx);
+            return idx;
+        }
+
+        array<value_type, _capacity> m_entries;
+        array<link, _capacity> m_links;
+        static_unordered_map<K, index_type, index_slots(), Hash, KeyEqual> m_index;
+        index_type m_head;
+        index_type m_tail;
+        index_type m_free;
+        index_type m_size;
+        uint32_t m_hits = 0;
+        uint32_t m_misses = 0;
+    };
+}
+#endif // ASTD_LRU_CACHE
\ No newline at end of file
@@ -426,13 +426,13 @@ namespace astd
         return !(lhs == rhs);
     }
 
-    template<typename T = void>
+    template<typename T>
     struct less;
 
     template<typename T, typename Deleter, typename T2, typename Deleter2>
     bool operator<(const unique_ptr<T, Deleter>& lhs, const unique_ptr<T2, Deleter2>& rhs)
     {
-        return less<common_type_t<unique_ptr<T, Deleter>::pointer, unique_ptr<T2, Deleter>::pointer>>()(lhs.get(), rhs.get());
+        return less<common_type_t<typename unique_ptr<T, Deleter>::pointer, typename unique_ptr<T2, Deleter2>::pointer>>()(lhs.get(), rhs.get());
     }
 
     template<typename T, typename Deleter, typename T2, typename Deleter2>
@@ -480,13 +480,13 @@ namespace astd
     template<typename T, typename Deleter>
     bool operator<(const unique_ptr<T, Deleter>& lhs, nullptr_t)
     {
-        return less<unique_ptr<T, Deleter>::pointer>()(lhs, nullptr);
+        return less<typename unique_ptr<T, Deleter>::pointer>()(lhs.get(), nullptr);
     }
 
     template<typename T, typename Deleter>
     bool operator<(nullptr_t, const unique_ptr<T, Deleter>& rhs)
     {
-        return less<unique_ptr<T, Deleter>::pointer>()(nullptr, rhs);
+        return less<typename unique_ptr<T, Deleter>::pointer>()(nullptr, rhs.get());
     }
 
     template<typename T, typename Deleter>
@@ -0,0 +1,415 @@
+#pragma once
+#ifndef ASTD_PACKED_ARRAY
+#define ASTD_PACKED_ARRAY
+#include "type_traits.h"
+#include "error.h"
+
+/*
+packed_array is not part of the STL. It stores _size unsigned fields of _bits bits each back to back,
+so e.g. 1000 3-bit codes take 375 bytes instead of 1000. The words are of the smallest unsigned type
+holding _bits, which keeps the shifts byte sized on AVR for fields up to 8 bits. A field may span two
+words unless _bits divides the word size.
+
+Element access goes through a proxy reference like bitset::reference. For runs of elements prefer
+get_n / set_n which walk the storage sequentially instead of recomputing the position per element.
+*/
+
+namespace astd
+{
+    template<size_t _bits>
+    using _packed_word_t = conditional_t<_bits <= 8, uint8_t, conditional_t<_bits <= 16, uint16_t, uint32_t>>;
+
+    template<size_t _bits, size_t _size>
+    class packed_array
+    {
+        static_assert(_bits > 0 && _bits <= 32, "packed_array supports fields of 1 to 32 bits");
+
+    public:
+        using value_type = _packed_word_t<_bits>;
+        using size_type = size_t;
+        using const_reference = value_type;
+
+    private:
+        using word_type = value_type;
+
+    public:
+        class reference
+        {
+            friend packed_array;
+
+        public:
+            reference& operator=(value_type val) noexcept
+            {
+                m_pArray->set_impl(m_idx, val);
+                return *this;
+            }
+
+            reference& operator=(const reference& ref) noexcept
+            {
+                m_pArray->set_impl(m_idx, static_cast<value_type>(ref));
+                return *this;
+            }
+
+            operator value_type() const noexcept
+            {
+                return m_pArray->get_impl(m_idx);
+            }
+
+        private:
+            reference(packed_array& arr, size_t idx) noexcept
+                :m_pArray(&arr), m_idx(idx)
+            {}
+
+            packed_array* m_pArray;
+            size_t m_idx;
+        };
+
+        template<bool _const>
+        class iterator_impl
+        {
+            friend packed_array;
+            friend iterator_impl<!_const>;
+            using container_type = conditional_t<_const, const packed_array, packed_array>;
+
+        public:
+            using value_type = packed_array::value_type;
+            using reference = conditional_t<_const, packed_array::const_reference, packed_array::reference>;
+
+            iterator_impl() noexcept = default;
+
+            // iterator converts to const_iterator
+            operator iterator_impl<true>() const noexcept
+            {
+                return iterator_impl<true>(*m_pArray, m_idx);
+            }
+
+            [[nodiscard]] reference operator*() const noexcept
+            {
+                return (*m_pArray)[m_idx];
+            }
+
+            [[nodiscard]] reference operator[](ptrdiff_t offset) const noexcept
+            {
+                return (*m_pArray)[m_idx + offset];
+            }
+
+            iterator_impl& operator++() noexcept
+            {
+                ++m_idx;
+                return *this;
+            }
+
+            iterator_impl operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++m_idx;
+                return ret;
+            }
+
+            iterator_impl& operator--() noexcept
+            {
+                --m_idx;
+                return *this;
+            }
+
+            iterator_impl operator--(int) noexcept
+            {
+                auto ret = *this;
+                --m_idx;
+                return ret;
+            }
+
+            iterator_impl& operator+=(ptrdiff_t offset) noexcept
+            {
+                m_idx += offset;
+                return *this;
+            }
+
+            iterator_impl& operator-=(ptrdiff_t offset) noexcept
+            {
+                m_idx -= offset;
+                return *this;
+            }
+
+            [[nodiscard]] iterator_impl operator+(ptrdiff_t offset) const noexcept
+            {
+                return iterator_impl(*m_pArray, m_idx + offset);
+            }
+
+            [[nodiscard]] iterator_impl operator-(ptrdiff_t offset) const noexcept
+            {
+                return iterator_impl(*m_pArray, m_idx - offset);
+            }
+
+            [[nodiscard]] friend iterator_impl operator+(ptrdiff_t offset, const iterator_impl& it) noexcept
+            {
+                return it + offset;
+            }
+
+            // the differences and comparisons also work between iterator and const_iterator
+            template<bool _otherConst>
+            [[nodiscard]] ptrdiff_t operator-(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return static_cast<ptrdiff_t>(m_idx) - static_cast<ptrdiff_t>(other.m_idx);
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] bool operator==(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return m_idx == other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] bool operator!=(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return m_idx != other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] bool operator<(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return m_idx < other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] bool operator<=(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return m_idx <= other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] bool operator>(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return m_idx > other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] bool operator>=(const iterator_impl<_otherConst>& other) const noexcept
+            {
+                return m_idx >= other.m_idx;
+            }
+
+        private:
+            iterator_impl(container_type& arr, size_t idx) noexcept
+                :m_pArray(&arr), m_idx(idx)
+            {}
+
+            container_type* m_pArray = nullptr;
+            size_t m_idx = 0;
+        };
+
+        using iterator = iterator_impl<false>;
+        using const_iterator = iterator_impl<true>;
+
+        constexpr packed_array() noexcept
+            :m_data{}
+        {}
+
+        void fill(value_type val) noexcept
+        {
+            for (size_t idx = 0; idx < _size; ++idx)
+                set_impl(idx, val);
+        }
+
+        [[nodiscard]] reference at(size_t idx)
+        {
+            verify(idx < _size, "invalid packed_array index");
+            return reference(*this, idx);
+        }
+
+        [[nodiscard]] value_type at(size_t idx) const
+        {
+            verify(idx < _size, "invalid packed_array index");
+            return get_impl(idx);
+        }
+
+        [[nodiscard]] reference operator[](size_t idx) noexcept
+        {
+#if _DEBUG
+            verify(idx < _size, "packed_array subscription out of range");
+#endif
+            return reference(*this, idx);
+        }
+
+        [[nodiscard]] value_type operator[](size_t idx) const noexcept
+        {
+#if _DEBUG
+            verify(idx < _size, "packed_array subscription out of range");
+#endif
+            return get_impl(idx);
+        }
+
+        [[nodiscard]] value_type get(size_t idx) const
+        {
+            verify(idx < _size, "invalid packed_array index");
+            return get_impl(idx);
+        }
+
+        void set(size_t idx, value_type val)
+        {
+            verify(idx < _size, "invalid packed_array index");
+            set_impl(idx, val);
+        }
+
+        // copies count elements starting at first into pOut
+        void get_n(size_t first, value_type* pOut, size_t count) const
+        {
+            verify(first <= _size && count <= _size - first, "packed_array range out of bounds");
+
+            size_t wordIdx = first * _bits / s_bitsInWord;
+            size_t offset = first * _bits % s_bitsInWord;
+            for (const auto* end = pOut + count; pOut < end; ++pOut)
+            {
+                *pOut = load_field(wordIdx, offset);
+                advance(wordIdx, offset);
+            }
+        }
+
+        // overwrites count elements starting at first with the values from pIn
+        void set_n(size_t first, const value_type* pIn, size_t count)
+        {
+            verify(first <= _size && count <= _size - first, "packed_array range out of bounds");
+
+            size_t wordIdx = first * _bits / s_bitsInWord;
+            size_t offset = first * _bits % s_bitsInWord;
+            for (const auto* end = pIn + count; pIn < end; ++pIn)
+            {
+                store_field(wordIdx, offset, *pIn);
+                advance(wordIdx, offset);
+            }
+        }
+
+        [[nodiscard]] reference front() noexcept
+        {
+            return reference(*this, 0);
+        }
+
+        [[nodiscard]] value_type front() const noexcept
+        {
+            return get_impl(0);
+        }
+
+        [[nodiscard]] reference back() noexcept
+        {
+            return reference(*this, _size - 1);
+        }
+
+        [[nodiscard]] value_type back() const noexcept
+        {
+            return get_impl(_size - 1);
+        }
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+            return iterator(*this, 0);
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return const_iterator(*this, 0);
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return iterator(*this, _size);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator(*this, _size);
+        }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept
+        {
+            return const_iterator(*this, 0);
+        }
+
+        [[nodiscard]] const_iterator cend() const noexcept
+        {
+            return const_iterator(*this, _size);
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return _size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        // raw storage, e.g. to persist it to EEPROM
+        [[nodiscard]] const word_type* data() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr size_t data_size() const noexcept
+        {
+            return sizeof(m_data);
+        }
+
+    private:
+        value_type get_impl(size_t idx) const noexcept
+        {
+            return load_field(idx * _bits / s_bitsInWord, idx * _bits % s_bitsInWord);
+        }
+
+        void set_impl(size_t idx, value_type val) noexcept
+        {
+            store_field(idx * _bits / s_bitsInWord, idx * _bits % s_bitsInWord, val);
+        }
+
+        value_type load_field(size_t wordIdx, size_t offset) const noexcept
+        {
+            auto val = static_cast<word_type>(m_data[wordIdx] >> offset);
+            if constexpr (s_bitsInWord % _bits != 0)
+            {
+                if (offset + _bits > s_bitsInWord) // field continues in the next word
+                    val |= static_cast<word_type>(m_data[wordIdx + 1] << (s_bitsInWord - offset));
+            }
+            return static_cast<value_type>(val & s_fieldMask);
+        }
+
+        void store_field(size_t wordIdx, size_t offset, value_type val) noexcept
+        {
+#if _DEBUG
+            verify((val & ~s_fieldMask) == 0, "value too wide for packed_array");
+#endif
+            val &= s_fieldMask;
+            m_data[wordIdx] = static_cast<word_type>((m_data[wordIdx] & ~(s_fieldMask << offset)) | (val << offset));
+            if constexpr (s_bitsInWord % _bits != 0)
+            {
+                if (offset + _bits > s_bitsInWord)
+                {
+                    const auto shift = s_bitsInWord - offset;
+                    m_data[wordIdx + 1] = static_cast<word_type>((m_data[wordIdx + 1] & ~(s_fieldMask >> shift)) | (val >> shift));
+                }
+            }
+        }
+
+        static void advance(size_t& wordIdx, size_t& offset) noexcept
+        {
+            offset += _bits;
+            if (offset >= s_bitsInWord)
+            {
+                offset -= s_bitsInWord;
+                ++wordIdx;
+            }
+        }
+
+        static constexpr size_t s_bitsInWord = 8 * sizeof(word_type);
+        static constexpr word_type s_fieldMask = _bits == s_bitsInWord ? static_cast<word_type>(~static_cast<word_type>(0))
+            : static_cast<word_type>((static_cast<word_type>(1) << (_bits % s_bitsInWord)) - 1);
+        static constexpr size_t s_arrSize = _size == 0 ? 1 : (_size * _bits - 1) / s_bitsInWord + 1;
+
+        word_type m_data[s_arrSize];
+    };
+}
+#endif // ASTD_PACKED_ARRAY
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef ASTD_PROGMEM
+#define ASTD_PROGMEM
+
+#include <avr/pgmspace.h>
+#include "type_traits.h"
+
+/*
+This is not part of the STL in any way. On AVR, data placed in flash via PROGMEM lives in a
+different address space and cannot be dereferenced like an ordinary pointer. It has to be loaded
+through the pgm_read_* family instead. pgm_read picks the right one for a given type, so views
+and containers can read from flash without caring about the element size.
+*/
+
+namespace astd
+{
+    template<typename T>
+    [[nodiscard]] inline remove_cv_t<T> pgm_read(const T* pAddr) noexcept
+    {
+        remove_cv_t<T> ret;
+        if constexpr (sizeof(T) == 1)
+        {
+            const uint8_t raw = pgm_read_byte(pAddr);
+            memcpy(&ret, &raw, sizeof(T));
+        }
+        else if constexpr (sizeof(T) == 2)
+        {
+            const uint16_t raw = pgm_read_word(pAddr);
+            memcpy(&ret, &raw, sizeof(T));
+        }
+        else if constexpr (sizeof(T) == 4)
+        {
+            const uint32_t raw = pgm_read_dword(pAddr);
+            memcpy(&ret, &raw, sizeof(T));
+        }
+        else
+            memcpy_P(&ret, pAddr, sizeof(T));
+        return ret;
+    }
+
+    // load policy for views and containers that read from flash
+    struct _pgm_loader
+    {
+        template<typename T>
+        static remove_cv_t<T> load(const T* pAddr) noexcept
+        {
+            return pgm_read(pAddr);
+        }
+    };
+}
+
+#endif // ASTD_PROGMEM
\ No newline at end of file
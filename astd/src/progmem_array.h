@@ -0,0 +1,268 @@
+#pragma once
+#ifndef ASTD_PROGMEM_ARRAY
+#define ASTD_PROGMEM_ARRAY
+#include "progmem.h"
+#include "array.h"
+#include "error.h"
+
+/*
+progmem_array is not part of the STL. It is an array meant to be placed in flash, for constant tables
+like gamma curves, sine tables or font glyphs that would otherwise occupy SRAM. Like array it is an
+aggregate, so it is initialized at compile time. PROGMEM is an attribute of the variable, not of
+the type, so it has to be given at the declaration:
+
+    const astd::progmem_array<uint8_t, 4> gamma PROGMEM = {{ 0, 1, 4, 9 }};
+
+Tables computed at compile time are put into flash through generate_progmem_array, or
+to_progmem_array of any constexpr array:
+
+    const astd::progmem_array<uint8_t, 16> squares PROGMEM = astd::generate_progmem_array<16>([](size_t idx) { return static_cast<uint8_t>(idx * idx); });
+
+Element access and iterators load through pgm_read (pgm_read_byte / word / dword or memcpy_P)
+and therefore return values instead of references. The iterators are random access, so algorithms
+that only read their input work on a progmem_array unchanged. Every read costs a few cycles more
+than an SRAM access.
+
+Only declare progmem_array objects with PROGMEM, reading one from SRAM through pgm_read returns
+garbage on AVR.
+*/
+
+namespace astd
+{
+    template<typename T, size_t _size>
+    struct progmem_array
+    {
+        using value_type = T;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+
+        class const_iterator
+        {
+        public:
+            using value_type = T;
+            using difference_type = ptrdiff_t;
+            using reference = T;
+            using pointer = const T*;
+
+            constexpr const_iterator() noexcept
+                :m_pAddr(nullptr)
+            {}
+
+            constexpr explicit const_iterator(const T* pAddr) noexcept
+                :m_pAddr(pAddr)
+            {}
+
+            [[nodiscard]] T operator*() const noexcept
+            {
+                return pgm_read(m_pAddr);
+            }
+
+            [[nodiscard]] T operator[](difference_type offset) const noexcept
+            {
+                return pgm_read(m_pAddr + offset);
+            }
+
+            constexpr const_iterator& operator++() noexcept
+            {
+                ++m_pAddr;
+                return *this;
+            }
+
+            constexpr const_iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++m_pAddr;
+                return ret;
+            }
+
+            constexpr const_iterator& operator--() noexcept
+            {
+                --m_pAddr;
+                return *this;
+            }
+
+            constexpr const_iterator operator--(int) noexcept
+            {
+                auto ret = *this;
+                --m_pAddr;
+                return ret;
+            }
+
+            constexpr const_iterator& operator+=(difference_type offset) noexcept
+            {
+                m_pAddr += offset;
+                return *this;
+            }
+
+            constexpr const_iterator& operator-=(difference_type offset) noexcept
+            {
+                m_pAddr -= offset;
+                return *this;
+            }
+
+            [[nodiscard]] constexpr const_iterator operator+(difference_type offset) const noexcept
+            {
+                return const_iterator(m_pAddr + offset);
+            }
+
+            [[nodiscard]] constexpr const_iterator operator-(difference_type offset) const noexcept
+            {
+                return const_iterator(m_pAddr - offset);
+            }
+
+            [[nodiscard]] friend constexpr const_iterator operator+(difference_type offset, const const_iterator& it) noexcept
+            {
+                return it + offset;
+            }
+
+            [[nodiscard]] constexpr difference_type operator-(const const_iterator& other) const noexcept
+            {
+                return m_pAddr - other.m_pAddr;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const const_iterator& other) const noexcept
+            {
+                return m_pAddr == other.m_pAddr;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const const_iterator& other) const noexcept
+            {
+                return m_pAddr != other.m_pAddr;
+            }
+
+            [[nodiscard]] constexpr bool operator<(const const_iterator& other) const noexcept
+            {
+                return m_pAddr < other.m_pAddr;
+            }
+
+            [[nodiscard]] constexpr bool operator<=(const const_iterator& other) const noexcept
+            {
+                return m_pAddr <= other.m_pAddr;
+            }
+
+            [[nodiscard]] constexpr bool operator>(const const_iterator& other) const noexcept
+            {
+                return m_pAddr > other.m_pAddr;
+            }
+
+            [[nodiscard]] constexpr bool operator>=(const const_iterator& other) const noexcept
+            {
+                return m_pAddr >= other.m_pAddr;
+            }
+
+            // flash address of the element
+            [[nodiscard]] constexpr const T* address() const noexcept
+            {
+                return m_pAddr;
+            }
+
+        private:
+            const T* m_pAddr;
+        };
+
+        using iterator = const_iterator;
+
+        [[nodiscard]] T at(size_t idx) const
+        {
+            verify(idx < _size, "invalid progmem_array index");
+            return pgm_read(m_data + idx);
+        }
+
+        [[nodiscard]] T operator[](size_t idx) const noexcept
+        {
+#if _DEBUG
+            verify(idx < _size, "progmem_array subscription out of range");
+#endif
+            return pgm_read(m_data + idx);
+        }
+
+        [[nodiscard]] T front() const noexcept
+        {
+            return pgm_read(m_data);
+        }
+
+        [[nodiscard]] T back() const noexcept
+        {
+            return pgm_read(m_data + _size - 1);
+        }
+
+        // copies count elements starting at offset to SRAM with a single memcpy_P, e.g. one glyph of a font
+        void read(size_t offset, T* pDst, size_t count) const
+        {
+            verify(offset <= _size && count <= _size - offset, "progmem_array::read out of range");
+            memcpy_P(pDst, m_data + offset, sizeof(T) * count);
+        }
+
+        // copies the whole table to SRAM
+        [[nodiscard]] array<T, _size> to_array() const noexcept
+        {
+            array<T, _size> ret;
+            memcpy_P(ret.data(), m_data, sizeof(m_data));
+            return ret;
+        }
+
+        // flash address of the first element, only to be read through pgm_read
+        [[nodiscard]] constexpr const T* data() const noexcept
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator(m_data);
+        }
+
+        [[nodiscard]] constexpr const_iterator end() const noexcept
+        {
+            return const_iterator(m_data + _size);
+        }
+
+        [[nodiscard]] constexpr const_iterator cbegin() const noexcept
+        {
+            return const_iterator(m_data);
+        }
+
+        [[nodiscard]] constexpr const_iterator cend() const noexcept
+        {
+            return const_iterator(m_data + _size);
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return _size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return false;
+        }
+
+        T m_data[_size];
+    };
+
+    template<typename T, size_t _size, size_t... idx>
+    constexpr progmem_array<T, _size> _to_progmem_array_impl(const array<T, _size>& arr, index_sequence<idx...>)
+    {
+        return progmem_array<T, _size>{ { arr.m_data[idx]... } };
+    }
+
+    // a progmem_array with the elements of arr, so a table computed at compile time can be put into flash
+    template<typename T, size_t _size>
+    [[nodiscard]] constexpr progmem_array<T, _size> to_progmem_array(const array<T, _size>& arr)
+    {
+        return _to_progmem_array_impl(arr, make_index_sequence<_size>());
+    }
+
+    // generate_array as progmem_array, element idx is func(idx), to be declared PROGMEM
+    template<size_t _size, typename Func>
+    [[nodiscard]] constexpr auto generate_progmem_array(Func func)
+    {
+        return to_progmem_array(generate_array<_size>(func));
+    }
+}
+#endif // ASTD_PROGMEM_ARRAY
\ No newline at end of file
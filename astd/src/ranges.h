@@ -0,0 +1,766 @@
+#pragma once
+#ifndef ASTD_RANGES
+#define ASTD_RANGES
+#include "type_traits.h"
+#include "utility.h"
+
+/*
+Mirrors a subset of the views of <ranges> (C++20 / C++23). A view adapts anything with begin() / end(),
+or a C array, lazily: nothing is computed or copied up front, every element passes through all stages
+of a pipeline when the loop reaches it. So a pipeline runs in a single pass, without allocations or
+temporary buffers, and inlines down to the equivalent hand written loop:
+
+    int32_t sum = 0;
+    for (auto val : samples | astd::views::filter(isValid) | astd::views::transform(scale) | astd::views::take(8))
+        sum += val;
+
+views::transform(f)    f(element)
+views::filter(pred)    the elements for which pred is true
+views::take(n)         the first n elements
+views::drop(n)         all but the first n elements
+views::stride(n)       every n-th element, starting with the first
+views::enumerate       pair<size_t, element&> of index and element
+views::zip(r1, r2)     pair<element1&, element2&>, as long as both ranges have elements
+views::set_bits(bits)  the indices of the set bits of a bitset, bitset_view or compressed_bitset
+
+Every adaptor except zip and set_bits can be called with the range as first argument or piped with |,
+zip and set_bits can only be called. Ranges given as lvalue are referenced and have to outlive the
+view, rvalues (e.g. other views or temporary bitsets) are moved into the view.
+
+Differences to std::views:
+The iterators are forward iterators, so views can be iterated but not sorted.
+Views only provide non const begin() / end().
+The functions of transform and filter are stored in the view, its iterators point to them, so they
+must not outlive the view.
+*/
+
+namespace astd
+{
+    template<typename R>
+    constexpr auto _range_begin(R& range) -> decltype(range.begin())
+    {
+        return range.begin();
+    }
+
+    template<typename T, size_t _size>
+    constexpr T* _range_begin(T(&arr)[_size]) noexcept
+    {
+        return arr;
+    }
+
+    template<typename R>
+    constexpr auto _range_end(R& range) -> decltype(range.end())
+    {
+        return range.end();
+    }
+
+    template<typename T, size_t _size>
+    constexpr T* _range_end(T(&arr)[_size]) noexcept
+    {
+        return arr + _size;
+    }
+
+    template<typename R>
+    using _range_iterator_t = decltype(_range_begin(declval<R&>()));
+
+    template<typename R>
+    using _range_reference_t = decltype(*declval<_range_iterator_t<R>&>());
+
+    // non owning view of all elements of a range
+    template<typename R>
+    class ref_view
+    {
+    public:
+        constexpr explicit ref_view(R& range) noexcept
+            :m_pRange(&range)
+        {}
+
+        [[nodiscard]] constexpr auto begin() const
+        {
+            return _range_begin(*m_pRange);
+        }
+
+        [[nodiscard]] constexpr auto end() const
+        {
+            return _range_end(*m_pRange);
+        }
+
+    private:
+        R* m_pRange;
+    };
+
+    // lvalues are referenced through a ref_view, rvalues are moved into the view
+    template<typename R>
+    using _all_t = conditional_t<is_lvalue_reference_v<R>, ref_view<remove_reference_t<R>>, remove_cv_t<remove_reference_t<R>>>;
+
+    template<typename R>
+    constexpr _all_t<R&&> _all(R&& range)
+    {
+        return _all_t<R&&>(forward<R>(range));
+    }
+
+    // the result of an adaptor called without range, applied to the range on the left of |
+    template<typename Fn>
+    struct _range_adaptor_closure
+    {
+        template<typename R>
+        [[nodiscard]] constexpr auto operator()(R&& range) const
+        {
+            return m_fn(forward<R>(range));
+        }
+
+        Fn m_fn;
+    };
+
+    template<typename Fn>
+    constexpr _range_adaptor_closure<Fn> _make_range_adaptor_closure(Fn fn)
+    {
+        return _range_adaptor_closure<Fn>{ astd::move(fn) };
+    }
+
+    template<typename R, typename Fn>
+    [[nodiscard]] constexpr auto operator|(R&& range, _range_adaptor_closure<Fn> closure)
+    {
+        return closure.m_fn(forward<R>(range));
+    }
+
+    template<typename V, typename F>
+    class transform_view
+    {
+        using base_iterator = _range_iterator_t<V>;
+
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+
+            constexpr iterator(base_iterator it, F* pFunc)
+                :m_it(it), m_pFunc(pFunc)
+            {}
+
+            [[nodiscard]] constexpr decltype(auto) operator*() const
+            {
+                return (*m_pFunc)(*m_it);
+            }
+
+            constexpr iterator& operator++()
+            {
+                ++m_it;
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                auto ret = *this;
+                ++m_it;
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const
+            {
+                return m_it == other.m_it;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            base_iterator m_it;
+            F* m_pFunc;
+        };
+
+        constexpr transform_view(V base, F func)
+            :m_base(astd::move(base)), m_func(astd::move(func))
+        {}
+
+        [[nodiscard]] constexpr iterator begin()
+        {
+            return iterator(_range_begin(m_base), &m_func);
+        }
+
+        [[nodiscard]] constexpr iterator end()
+        {
+            return iterator(_range_end(m_base), &m_func);
+        }
+
+    private:
+        V m_base;
+        F m_func;
+    };
+
+    template<typename V, typename Pred>
+    class filter_view
+    {
+        using base_iterator = _range_iterator_t<V>;
+
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+
+            constexpr iterator(base_iterator it, base_iterator end, Pred* pPred)
+                :m_it(it), m_end(end), m_pPred(pPred)
+            {
+                skip_rejected();
+            }
+
+            [[nodiscard]] constexpr decltype(auto) operator*() const
+            {
+                return *m_it;
+            }
+
+            constexpr iterator& operator++()
+            {
+                ++m_it;
+                skip_rejected();
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const
+            {
+                return m_it == other.m_it;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            constexpr void skip_rejected()
+            {
+                while (m_it != m_end && !(*m_pPred)(*m_it))
+                    ++m_it;
+            }
+
+            base_iterator m_it;
+            base_iterator m_end;
+            Pred* m_pPred;
+        };
+
+        constexpr filter_view(V base, Pred pred)
+            :m_base(astd::move(base)), m_pred(astd::move(pred))
+        {}
+
+        // searches the first accepted element on every call
+        [[nodiscard]] constexpr iterator begin()
+        {
+            return iterator(_range_begin(m_base), _range_end(m_base), &m_pred);
+        }
+
+        [[nodiscard]] constexpr iterator end()
+        {
+            return iterator(_range_end(m_base), _range_end(m_base), &m_pred);
+        }
+
+    private:
+        V m_base;
+        Pred m_pred;
+    };
+
+    template<typename V>
+    class take_view
+    {
+        using base_iterator = _range_iterator_t<V>;
+
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+
+            constexpr iterator(base_iterator it, size_t count)
+                :m_it(it), m_count(count)
+            {}
+
+            [[nodiscard]] constexpr decltype(auto) operator*() const
+            {
+                return *m_it;
+            }
+
+            constexpr iterator& operator++()
+            {
+                ++m_it;
+                --m_count;
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            // the end is reached after count elements or at the end of the base range
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const
+            {
+                return m_count == other.m_count || m_it == other.m_it;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            base_iterator m_it;
+            size_t m_count;
+        };
+
+        constexpr take_view(V base, size_t count)
+            :m_base(astd::move(base)), m_count(count)
+        {}
+
+        [[nodiscard]] constexpr iterator begin()
+        {
+            return iterator(_range_begin(m_base), m_count);
+        }
+
+        [[nodiscard]] constexpr iterator end()
+        {
+            return iterator(_range_end(m_base), 0);
+        }
+
+    private:
+        V m_base;
+        size_t m_count;
+    };
+
+    template<typename V>
+    class drop_view
+    {
+    public:
+        constexpr drop_view(V base, size_t count)
+            :m_base(astd::move(base)), m_count(count)
+        {}
+
+        // steps over the dropped elements on every call
+        [[nodiscard]] constexpr auto begin()
+        {
+            auto it = _range_begin(m_base);
+            const auto end = _range_end(m_base);
+            for (size_t idx = 0; idx < m_count && it != end; ++idx)
+                ++it;
+            return it;
+        }
+
+        [[nodiscard]] constexpr auto end()
+        {
+            return _range_end(m_base);
+        }
+
+    private:
+        V m_base;
+        size_t m_count;
+    };
+
+    template<typename V>
+    class stride_view
+    {
+        using base_iterator = _range_iterator_t<V>;
+
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+
+            constexpr iterator(base_iterator it, base_iterator end, size_t step)
+                :m_it(it), m_end(end), m_step(step)
+            {}
+
+            [[nodiscard]] constexpr decltype(auto) operator*() const
+            {
+                return *m_it;
+            }
+
+            constexpr iterator& operator++()
+            {
+                for (size_t idx = 0; idx < m_step && m_it != m_end; ++idx)
+                    ++m_it;
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const
+            {
+                return m_it == other.m_it;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            base_iterator m_it;
+            base_iterator m_end;
+            size_t m_step;
+        };
+
+        constexpr stride_view(V base, size_t step)
+            :m_base(astd::move(base)), m_step(step)
+        {}
+
+        [[nodiscard]] constexpr iterator begin()
+        {
+            return iterator(_range_begin(m_base), _range_end(m_base), m_step);
+        }
+
+        [[nodiscard]] constexpr iterator end()
+        {
+            return iterator(_range_end(m_base), _range_end(m_base), m_step);
+        }
+
+    private:
+        V m_base;
+        size_t m_step;
+    };
+
+    template<typename V>
+    class enumerate_view
+    {
+        using base_iterator = _range_iterator_t<V>;
+
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+            using value_type = pair<size_t, _range_reference_t<V>>;
+
+            constexpr iterator(base_iterator it, size_t idx)
+                :m_it(it), m_idx(idx)
+            {}
+
+            [[nodiscard]] constexpr value_type operator*() const
+            {
+                return value_type(m_idx, *m_it);
+            }
+
+            constexpr iterator& operator++()
+            {
+                ++m_it;
+                ++m_idx;
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const
+            {
+                return m_it == other.m_it;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            base_iterator m_it;
+            size_t m_idx;
+        };
+
+        constexpr explicit enumerate_view(V base)
+            :m_base(astd::move(base))
+        {}
+
+        [[nodiscard]] constexpr iterator begin()
+        {
+            return iterator(_range_begin(m_base), 0);
+        }
+
+        // the index of the end is never compared
+        [[nodiscard]] constexpr iterator end()
+        {
+            return iterator(_range_end(m_base), 0);
+        }
+
+    private:
+        V m_base;
+    };
+
+    template<typename V1, typename V2>
+    class zip_view
+    {
+        using base_iterator1 = _range_iterator_t<V1>;
+        using base_iterator2 = _range_iterator_t<V2>;
+
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+            using value_type = pair<_range_reference_t<V1>, _range_reference_t<V2>>;
+
+            constexpr iterator(base_iterator1 it1, base_iterator2 it2)
+                :m_it1(it1), m_it2(it2)
+            {}
+
+            [[nodiscard]] constexpr value_type operator*() const
+            {
+                return value_type(*m_it1, *m_it2);
+            }
+
+            constexpr iterator& operator++()
+            {
+                ++m_it1;
+                ++m_it2;
+                return *this;
+            }
+
+            constexpr iterator operator++(int)
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            // the end is reached at the end of the shorter range
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const
+            {
+                return m_it1 == other.m_it1 || m_it2 == other.m_it2;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const
+            {
+                return !(*this == other);
+            }
+
+        private:
+            base_iterator1 m_it1;
+            base_iterator2 m_it2;
+        };
+
+        constexpr zip_view(V1 base1, V2 base2)
+            :m_base1(astd::move(base1)), m_base2(astd::move(base2))
+        {}
+
+        [[nodiscard]] constexpr iterator begin()
+        {
+            return iterator(_range_begin(m_base1), _range_begin(m_base2));
+        }
+
+        [[nodiscard]] constexpr iterator end()
+        {
+            return iterator(_range_end(m_base1), _range_end(m_base2));
+        }
+
+    private:
+        V1 m_base1;
+        V2 m_base2;
+    };
+
+    // the indices of the set bits of anything with find_first / find_next / size, like bitset.
+    // Bitsets given as rvalue are moved into the view, like the ranges of the other views
+    template<typename Bits, bool _owning = false>
+    class set_bits_view
+    {
+    public:
+        class iterator
+        {
+        public:
+            using difference_type = ptrdiff_t;
+            using value_type = size_t;
+
+            constexpr iterator(const Bits* pBits, size_t idx) noexcept
+                :m_pBits(pBits), m_idx(idx)
+            {}
+
+            [[nodiscard]] constexpr size_t operator*() const noexcept
+            {
+                return m_idx;
+            }
+
+            iterator& operator++() noexcept
+            {
+                m_idx = m_pBits->find_next(m_idx);
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const iterator& other) const noexcept
+            {
+                return m_idx == other.m_idx;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const iterator& other) const noexcept
+            {
+                return m_idx != other.m_idx;
+            }
+
+        private:
+            const Bits* m_pBits;
+            size_t m_idx;
+        };
+
+        template<bool _o = _owning, enable_if_t<!_o, int> = 0>
+        constexpr explicit set_bits_view(const Bits& bits) noexcept
+            :m_bits(&bits)
+        {}
+
+        template<bool _o = _owning, enable_if_t<_o, int> = 0>
+        constexpr explicit set_bits_view(Bits&& bits)
+            :m_bits(astd::move(bits))
+        {}
+
+        [[nodiscard]] iterator begin() const noexcept
+        {
+            return iterator(&bits(), bits().find_first());
+        }
+
+        [[nodiscard]] iterator end() const noexcept
+        {
+            return iterator(&bits(), bits().size());
+        }
+
+    private:
+        [[nodiscard]] constexpr const Bits& bits() const noexcept
+        {
+            if constexpr (_owning)
+                return m_bits;
+            else
+                return *m_bits;
+        }
+
+        conditional_t<_owning, Bits, const Bits*> m_bits;
+    };
+
+    namespace views
+    {
+        template<typename R>
+        [[nodiscard]] constexpr auto all(R&& range)
+        {
+            return _all(forward<R>(range));
+        }
+
+        template<typename R, typename F>
+        [[nodiscard]] constexpr auto transform(R&& range, F func)
+        {
+            return transform_view<_all_t<R&&>, F>(_all(forward<R>(range)), astd::move(func));
+        }
+
+        template<typename F>
+        [[nodiscard]] constexpr auto transform(F func)
+        {
+            return _make_range_adaptor_closure([func](auto&& range) {
+                return views::transform(forward<decltype(range)>(range), func);
+            });
+        }
+
+        template<typename R, typename Pred>
+        [[nodiscard]] constexpr auto filter(R&& range, Pred pred)
+        {
+            return filter_view<_all_t<R&&>, Pred>(_all(forward<R>(range)), astd::move(pred));
+        }
+
+        template<typename Pred>
+        [[nodiscard]] constexpr auto filter(Pred pred)
+        {
+            return _make_range_adaptor_closure([pred](auto&& range) {
+                return views::filter(forward<decltype(range)>(range), pred);
+            });
+        }
+
+        template<typename R>
+        [[nodiscard]] constexpr auto take(R&& range, size_t count)
+        {
+            return take_view<_all_t<R&&>>(_all(forward<R>(range)), count);
+        }
+
+        [[nodiscard]] constexpr auto take(size_t count)
+        {
+            return _make_range_adaptor_closure([count](auto&& range) {
+                return views::take(forward<decltype(range)>(range), count);
+            });
+        }
+
+        template<typename R>
+        [[nodiscard]] constexpr auto drop(R&& range, size_t count)
+        {
+            return drop_view<_all_t<R&&>>(_all(forward<R>(range)), count);
+        }
+
+        [[nodiscard]] constexpr auto drop(size_t count)
+        {
+            return _make_range_adaptor_closure([count](auto&& range) {
+                return views::drop(forward<decltype(range)>(range), count);
+            });
+        }
+
+        template<typename R>
+        [[nodiscard]] constexpr auto stride(R&& range, size_t step)
+        {
+            return stride_view<_all_t<R&&>>(_all(forward<R>(range)), step);
+        }
+
+        [[nodiscard]] constexpr auto stride(size_t step)
+        {
+            return _make_range_adaptor_closure([step](auto&& range) {
+                return views::stride(forward<decltype(range)>(range), step);
+            });
+        }
+
+        struct _enumerate_fn
+        {
+            template<typename R>
+            [[nodiscard]] constexpr auto operator()(R&& range) const
+            {
+                return enumerate_view<_all_t<R&&>>(_all(forward<R>(range)));
+            }
+        };
+
+        // views::enumerate(range) or range | views::enumerate
+        constexpr _range_adaptor_closure<_enumerate_fn> enumerate{};
+
+        template<typename R1, typename R2>
+        [[nodiscard]] constexpr auto zip(R1&& range1, R2&& range2)
+        {
+            return zip_view<_all_t<R1&&>, _all_t<R2&&>>(_all(forward<R1>(range1)), _all(forward<R2>(range2)));
+        }
+
+        template<typename Bits>
+        [[nodiscard]] constexpr auto set_bits(const Bits& bits) noexcept
+        {
+            return set_bits_view<Bits>(bits);
+        }
+
+        // a temporary bitset is kept alive by moving it into the view
+        template<typename Bits, enable_if_t<!is_lvalue_reference_v<Bits>, int> = 0>
+        [[nodiscard]] constexpr auto set_bits(Bits&& bits)
+        {
+            return set_bits_view<remove_cv_t<Bits>, true>(astd::move(bits));
+        }
+    }
+}
+#endif // ASTD_RANGES
\ No newline at end of file
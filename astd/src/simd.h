@@ -0,0 +1,255 @@
+#pragma once
+#ifndef ASTD_SIMD
+#define ASTD_SIMD
+#include "bit.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+/*
+This is not part of the STL in any way. These are the bulk kernels bitset runs over its words. When
+the library is compiled for a host (e.g. a simulator or replay tool on x86-64 or AArch64) they process
+a vector of 16 or 32 bytes per step with AVX2, SSE2 or NEON, whichever the compiler targets. The
+remaining words and every AVR build go through the plain word loops.
+
+All kernels take a word count, the vector width is always a multiple of the word size so the scalar
+tail starts at a word boundary.
+*/
+
+namespace astd
+{
+    enum class _words_op
+    {
+        bit_and,
+        bit_or,
+        bit_xor
+    };
+
+    template<_words_op _op, typename T>
+    constexpr T _apply_words_op(T lhs, T rhs) noexcept
+    {
+        if constexpr (_op == _words_op::bit_and)
+            return lhs & rhs;
+        else if constexpr (_op == _words_op::bit_or)
+            return lhs | rhs;
+        else
+            return lhs ^ rhs;
+    }
+
+    // pDst[idx] = pDst[idx] op pSrc[idx]
+    template<_words_op _op, typename T>
+    inline void _words_apply(T* pDst, const T* pSrc, size_t count) noexcept
+    {
+        size_t idx = 0;
+#if defined(__AVX2__)
+        constexpr size_t perVec = sizeof(__m256i) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pDst + idx));
+            const auto rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSrc + idx));
+            __m256i res;
+            if constexpr (_op == _words_op::bit_and)
+                res = _mm256_and_si256(lhs, rhs);
+            else if constexpr (_op == _words_op::bit_or)
+                res = _mm256_or_si256(lhs, rhs);
+            else
+                res = _mm256_xor_si256(lhs, rhs);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(pDst + idx), res);
+        }
+#elif defined(__SSE2__)
+        constexpr size_t perVec = sizeof(__m128i) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pDst + idx));
+            const auto rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + idx));
+            __m128i res;
+            if constexpr (_op == _words_op::bit_and)
+                res = _mm_and_si128(lhs, rhs);
+            else if constexpr (_op == _words_op::bit_or)
+                res = _mm_or_si128(lhs, rhs);
+            else
+                res = _mm_xor_si128(lhs, rhs);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + idx), res);
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        constexpr size_t perVec = sizeof(uint8x16_t) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto lhs = vld1q_u8(reinterpret_cast<const uint8_t*>(pDst + idx));
+            const auto rhs = vld1q_u8(reinterpret_cast<const uint8_t*>(pSrc + idx));
+            uint8x16_t res;
+            if constexpr (_op == _words_op::bit_and)
+                res = vandq_u8(lhs, rhs);
+            else if constexpr (_op == _words_op::bit_or)
+                res = vorrq_u8(lhs, rhs);
+            else
+                res = veorq_u8(lhs, rhs);
+            vst1q_u8(reinterpret_cast<uint8_t*>(pDst + idx), res);
+        }
+#endif
+        for (; idx < count; ++idx)
+            pDst[idx] = _apply_words_op<_op>(pDst[idx], pSrc[idx]);
+    }
+
+    // number of set bits in count words
+    template<typename T>
+    [[nodiscard]] inline size_t _words_popcount(const T* pWords, size_t count) noexcept
+    {
+        size_t result = 0;
+        size_t idx = 0;
+#if defined(__AVX2__)
+        // nibble lookup per byte, horizontal byte sums via sad
+        constexpr size_t perVec = sizeof(__m256i) / sizeof(T);
+        const auto lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const auto lowMask = _mm256_set1_epi8(0x0F);
+        auto acc = _mm256_setzero_si256();
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + idx));
+            const auto lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(vec, lowMask));
+            const auto hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(vec, 4), lowMask));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+        }
+        result += static_cast<size_t>(_mm256_extract_epi64(acc, 0)) + static_cast<size_t>(_mm256_extract_epi64(acc, 1))
+            + static_cast<size_t>(_mm256_extract_epi64(acc, 2)) + static_cast<size_t>(_mm256_extract_epi64(acc, 3));
+#elif defined(__SSE2__)
+        // bit sliced popcount per byte, horizontal byte sums via sad
+        constexpr size_t perVec = sizeof(__m128i) / sizeof(T);
+        const auto mask55 = _mm_set1_epi8(0x55);
+        const auto mask33 = _mm_set1_epi8(0x33);
+        const auto mask0F = _mm_set1_epi8(0x0F);
+        auto acc = _mm_setzero_si128();
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + idx));
+            vec = _mm_sub_epi8(vec, _mm_and_si128(_mm_srli_epi16(vec, 1), mask55));
+            vec = _mm_add_epi8(_mm_and_si128(vec, mask33), _mm_and_si128(_mm_srli_epi16(vec, 2), mask33));
+            vec = _mm_and_si128(_mm_add_epi8(vec, _mm_srli_epi16(vec, 4)), mask0F);
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(vec, _mm_setzero_si128()));
+        }
+        result += static_cast<size_t>(_mm_cvtsi128_si32(acc)) + static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(acc, 8)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        constexpr size_t perVec = sizeof(uint8x16_t) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+            result += vaddvq_u8(vcntq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(pWords + idx))));
+#endif
+        for (; idx < count; ++idx)
+            result += popcount(pWords[idx]);
+        return result;
+    }
+
+    // true if any bit of count words is set
+    template<typename T>
+    [[nodiscard]] inline bool _words_any(const T* pWords, size_t count) noexcept
+    {
+        size_t idx = 0;
+#if defined(__AVX2__)
+        constexpr size_t perVec = sizeof(__m256i) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + idx));
+            if (!_mm256_testz_si256(vec, vec))
+                return true;
+        }
+#elif defined(__SSE2__)
+        constexpr size_t perVec = sizeof(__m128i) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + idx));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(vec, _mm_setzero_si128())) != 0xFFFF)
+                return true;
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        constexpr size_t perVec = sizeof(uint8x16_t) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+            if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(pWords + idx))) != 0)
+                return true;
+#endif
+        for (; idx < count; ++idx)
+            if (pWords[idx] != static_cast<T>(0))
+                return true;
+
+        return false;
+    }
+
+    // true if every bit of count words is set
+    template<typename T>
+    [[nodiscard]] inline bool _words_all(const T* pWords, size_t count) noexcept
+    {
+        size_t idx = 0;
+#if defined(__AVX2__)
+        constexpr size_t perVec = sizeof(__m256i) / sizeof(T);
+        const auto ones = _mm256_set1_epi8(-1);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+            if (!_mm256_testc_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pWords + idx)), ones))
+                return false;
+#elif defined(__SSE2__)
+        constexpr size_t perVec = sizeof(__m128i) / sizeof(T);
+        const auto ones = _mm_set1_epi8(-1);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pWords + idx));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(vec, ones)) != 0xFFFF)
+                return false;
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        constexpr size_t perVec = sizeof(uint8x16_t) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+            if (vminvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(pWords + idx))) != 0xFF)
+                return false;
+#endif
+        for (; idx < count; ++idx)
+            if (pWords[idx] != static_cast<T>(~static_cast<T>(0)))
+                return false;
+
+        return true;
+    }
+
+    // true if count words of both ranges are equal
+    template<typename T>
+    [[nodiscard]] inline bool _words_equal(const T* pLhs, const T* pRhs, size_t count) noexcept
+    {
+        size_t idx = 0;
+#if defined(__AVX2__)
+        constexpr size_t perVec = sizeof(__m256i) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto diff = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pLhs + idx)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pRhs + idx)));
+            if (!_mm256_testz_si256(diff, diff))
+                return false;
+        }
+#elif defined(__SSE2__)
+        constexpr size_t perVec = sizeof(__m128i) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pLhs + idx));
+            const auto rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pRhs + idx));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs)) != 0xFFFF)
+                return false;
+        }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        constexpr size_t perVec = sizeof(uint8x16_t) / sizeof(T);
+        for (const auto vecEnd = count - count % perVec; idx < vecEnd; idx += perVec)
+        {
+            const auto diff = veorq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(pLhs + idx)),
+                vld1q_u8(reinterpret_cast<const uint8_t*>(pRhs + idx)));
+            if (vmaxvq_u8(diff) != 0)
+                return false;
+        }
+#endif
+        for (; idx < count; ++idx)
+            if (pLhs[idx] != pRhs[idx])
+                return false;
+
+        return true;
+    }
+}
+
+#endif // ASTD_SIMD
\ No newline at end of file
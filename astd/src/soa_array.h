@@ -0,0 +1,361 @@
+#pragma once
+#ifndef ASTD_SOA_ARRAY
+#define ASTD_SOA_ARRAY
+#include "type_traits.h"
+#include "utility.h"
+#include "array.h"
+#include "span.h"
+#include "error.h"
+
+/*
+soa_array is not part of the STL. It holds _size records of the types Fields... as a structure of
+arrays: every field lives in its own contiguous array, instead of an array<struct, _size> where the
+fields of one record are next to each other. Loops that only touch one or two fields then stream
+through dense memory:
+
+    astd::soa_array<64, int16_t, int16_t, uint8_t> particles; // x, y, brightness
+    for (auto& x : particles.field<0>())
+        x += 3;
+
+On hosts such loops vectorize, the columns are aligned to 32 bytes for it. On AVR every column is
+an array at a fixed address, so the access is a pointer increment instead of a multiply or an add of
+the record size per element.
+
+field<I>() returns a span of a whole column and column<I>() the array itself. Element wise access
+goes through a proxy, operator[] and the iterators return one whose get<I>() is the field I of the
+record.
+*/
+
+namespace astd
+{
+    template<size_t _idx, typename T, typename... Ts>
+    struct _nth_type
+    {
+        using type = typename _nth_type<_idx - 1, Ts...>::type;
+    };
+
+    template<typename T, typename... Ts>
+    struct _nth_type<0, T, Ts...>
+    {
+        using type = T;
+    };
+
+    template<size_t _idx, typename... Ts>
+    using _nth_type_t = typename _nth_type<_idx, Ts...>::type;
+
+    // one column of a soa_array, tagged with its index so equal field types stay distinct bases
+    template<size_t _idx, typename T, size_t _size>
+    struct _soa_column
+    {
+#ifdef __AVR__
+        static constexpr size_t s_align = alignof(T);
+#else
+        // the width of an AVX register, so field wise loops do not need a peeling prologue
+        static constexpr size_t s_align = alignof(T) > 32 ? alignof(T) : 32;
+#endif // __AVR__
+
+        alignas(s_align) array<T, _size> m_column;
+    };
+
+    template<size_t _size, typename Seq, typename... Fields>
+    struct _soa_storage;
+
+    template<size_t _size, size_t... idx, typename... Fields>
+    struct _soa_storage<_size, index_sequence<idx...>, Fields...> : _soa_column<idx, Fields, _size>...
+    {};
+
+    template<size_t _size, typename... Fields>
+    class soa_array : private _soa_storage<_size, index_sequence_for<Fields...>, Fields...>
+    {
+        static_assert(sizeof...(Fields) > 0, "soa_array needs at least one field");
+        static_assert(_size > 0, "soa_array needs at least one record");
+
+    public:
+        template<size_t _idx>
+        using field_type = _nth_type_t<_idx, Fields...>;
+
+        using size_type = size_t;
+
+        static constexpr size_t field_count = sizeof...(Fields);
+
+        // the fields of one record, only valid as long as the soa_array
+        template<bool _is_const>
+        class _proxy
+        {
+            using soa_pointer = conditional_t<_is_const, const soa_array*, soa_array*>;
+
+        public:
+            constexpr _proxy(soa_pointer pSoa, size_t idx) noexcept
+                :m_pSoa(pSoa), m_idx(idx)
+            {}
+
+            template<size_t _field>
+            [[nodiscard]] constexpr auto& get() const noexcept
+            {
+                return m_pSoa->template column<_field>()[m_idx];
+            }
+
+            // assigns all fields of the record at once
+            template<bool _c = _is_const, enable_if_t<!_c, int> = 0>
+            constexpr void set(const Fields&... vals) const
+            {
+                m_pSoa->set(m_idx, vals...);
+            }
+
+            [[nodiscard]] constexpr size_t index() const noexcept
+            {
+                return m_idx;
+            }
+
+        private:
+            soa_pointer m_pSoa;
+            size_t m_idx;
+        };
+
+        using reference = _proxy<false>;
+        using const_reference = _proxy<true>;
+
+        // random access iterator over the records, dereferencing returns a proxy by value
+        template<bool _is_const>
+        class _iterator
+        {
+            using soa_pointer = conditional_t<_is_const, const soa_array*, soa_array*>;
+
+        public:
+            using value_type = _proxy<_is_const>;
+            using difference_type = ptrdiff_t;
+            using reference = _proxy<_is_const>;
+
+            constexpr _iterator(soa_pointer pSoa, size_t idx) noexcept
+                :m_pSoa(pSoa), m_idx(idx)
+            {}
+
+            // iterator to const_iterator
+            template<bool _otherConst, enable_if_t<_is_const && !_otherConst, int> = 0>
+            constexpr _iterator(const _iterator<_otherConst>& other) noexcept
+                :m_pSoa(other.m_pSoa), m_idx(other.m_idx)
+            {}
+
+            [[nodiscard]] constexpr reference operator*() const noexcept
+            {
+                return reference(m_pSoa, m_idx);
+            }
+
+            [[nodiscard]] constexpr reference operator[](difference_type offset) const noexcept
+            {
+                return reference(m_pSoa, m_idx + offset);
+            }
+
+            constexpr _iterator& operator++() noexcept
+            {
+                ++m_idx;
+                return *this;
+            }
+
+            constexpr _iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++m_idx;
+                return ret;
+            }
+
+            constexpr _iterator& operator--() noexcept
+            {
+                --m_idx;
+                return *this;
+            }
+
+            constexpr _iterator operator--(int) noexcept
+            {
+                auto ret = *this;
+                --m_idx;
+                return ret;
+            }
+
+            constexpr _iterator& operator+=(difference_type offset) noexcept
+            {
+                m_idx += offset;
+                return *this;
+            }
+
+            constexpr _iterator& operator-=(difference_type offset) noexcept
+            {
+                m_idx -= offset;
+                return *this;
+            }
+
+            [[nodiscard]] constexpr _iterator operator+(difference_type offset) const noexcept
+            {
+                return _iterator(m_pSoa, m_idx + offset);
+            }
+
+            [[nodiscard]] constexpr _iterator operator-(difference_type offset) const noexcept
+            {
+                return _iterator(m_pSoa, m_idx - offset);
+            }
+
+            [[nodiscard]] friend constexpr _iterator operator+(difference_type offset, const _iterator& it) noexcept
+            {
+                return it + offset;
+            }
+
+            // the differences and comparisons also work between iterator and const_iterator
+            template<bool _otherConst>
+            [[nodiscard]] constexpr difference_type operator-(const _iterator<_otherConst>& other) const noexcept
+            {
+                return static_cast<difference_type>(m_idx) - static_cast<difference_type>(other.m_idx);
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] constexpr bool operator==(const _iterator<_otherConst>& other) const noexcept
+            {
+                return m_idx == other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] constexpr bool operator!=(const _iterator<_otherConst>& other) const noexcept
+            {
+                return m_idx != other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] constexpr bool operator<(const _iterator<_otherConst>& other) const noexcept
+            {
+                return m_idx < other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] constexpr bool operator<=(const _iterator<_otherConst>& other) const noexcept
+            {
+                return m_idx <= other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] constexpr bool operator>(const _iterator<_otherConst>& other) const noexcept
+            {
+                return m_idx > other.m_idx;
+            }
+
+            template<bool _otherConst>
+            [[nodiscard]] constexpr bool operator>=(const _iterator<_otherConst>& other) const noexcept
+            {
+                return m_idx >= other.m_idx;
+            }
+
+        private:
+            friend class _iterator<!_is_const>;
+
+            soa_pointer m_pSoa;
+            size_t m_idx;
+        };
+
+        using iterator = _iterator<false>;
+        using const_iterator = _iterator<true>;
+
+        template<size_t _field>
+        [[nodiscard]] constexpr array<field_type<_field>, _size>& column() noexcept
+        {
+            return static_cast<_soa_column<_field, field_type<_field>, _size>&>(*this).m_column;
+        }
+
+        template<size_t _field>
+        [[nodiscard]] constexpr const array<field_type<_field>, _size>& column() const noexcept
+        {
+            return static_cast<const _soa_column<_field, field_type<_field>, _size>&>(*this).m_column;
+        }
+
+        template<size_t _field>
+        [[nodiscard]] span<field_type<_field>, _size> field() noexcept
+        {
+            return span<field_type<_field>, _size>(column<_field>());
+        }
+
+        template<size_t _field>
+        [[nodiscard]] span<const field_type<_field>, _size> field() const noexcept
+        {
+            return span<const field_type<_field>, _size>(column<_field>());
+        }
+
+        [[nodiscard]] constexpr reference operator[](size_t idx) noexcept
+        {
+#if _DEBUG
+            verify(idx < _size, "soa_array subscription out of range");
+#endif
+            return reference(this, idx);
+        }
+
+        [[nodiscard]] constexpr const_reference operator[](size_t idx) const noexcept
+        {
+#if _DEBUG
+            verify(idx < _size, "soa_array subscription out of range");
+#endif
+            return const_reference(this, idx);
+        }
+
+        [[nodiscard]] constexpr iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        [[nodiscard]] constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        [[nodiscard]] constexpr iterator end() noexcept
+        {
+            return iterator(this, _size);
+        }
+
+        [[nodiscard]] constexpr const_iterator end() const noexcept
+        {
+            return const_iterator(this, _size);
+        }
+
+        [[nodiscard]] constexpr const_iterator cbegin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        [[nodiscard]] constexpr const_iterator cend() const noexcept
+        {
+            return const_iterator(this, _size);
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return _size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return _size == 0;
+        }
+
+        // assigns all fields of the record at idx
+        constexpr void set(size_t idx, const Fields&... vals)
+        {
+            set_impl(idx, index_sequence_for<Fields...>(), vals...);
+        }
+
+        // fills every column with the value of its field
+        constexpr void fill(const Fields&... vals)
+        {
+            fill_impl(index_sequence_for<Fields...>(), vals...);
+        }
+
+    private:
+        template<size_t... idx>
+        constexpr void set_impl(size_t record, index_sequence<idx...>, const Fields&... vals)
+        {
+            ((column<idx>()[record] = vals), ...);
+        }
+
+        template<size_t... idx>
+        constexpr void fill_impl(index_sequence<idx...>, const Fields&... vals)
+        {
+            (column<idx>().fill(vals), ...);
+        }
+    };
+}
+#endif // ASTD_SOA_ARRAY
\ No newline at end of file
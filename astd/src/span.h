@@ -0,0 +1,268 @@
+#pragma once
+#ifndef ASTD_SPAN
+#define ASTD_SPAN
+#include "array.h"
+#include "type_traits.h"
+#include "error.h"
+
+/*
+Mirrors std::span of C++20. A span is a non owning view of contiguous elements, so a single non
+template function taking span<const uint8_t> can process an array of any size, a C array, a
+static_vector or a pointer / length pair without copying and without one instantiation per size.
+
+With a static Extent only the pointer is stored, with dynamic_extent the size as well.
+
+Differences to std::span:
+as_bytes / as_writable_bytes return spans of uint8_t since there is no std::byte.
+Out of range subspan / first / last are reported through verify, subscripts only #if _DEBUG. verify is
+only called on failure, so spans of constant data can be evaluated at compile time.
+*/
+
+namespace astd
+{
+    constexpr size_t dynamic_extent = static_cast<size_t>(-1);
+
+    template<typename T, size_t Extent = dynamic_extent>
+    class span;
+
+    template<size_t Extent>
+    class _span_extent
+    {
+    public:
+        constexpr explicit _span_extent(size_t) noexcept
+        {}
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return Extent;
+        }
+    };
+
+    template<>
+    class _span_extent<dynamic_extent>
+    {
+    public:
+        constexpr explicit _span_extent(size_t size) noexcept
+            :m_size(size)
+        {}
+
+        [[nodiscard]] constexpr size_t size() const noexcept
+        {
+            return m_size;
+        }
+
+    private:
+        size_t m_size;
+    };
+
+    // true for types with data() and size() whose elements can be viewed as T, e.g. static_vector
+    template<typename, typename C, typename T>
+    struct _is_span_compatible_container_impl : false_type
+    {};
+
+    template<typename C, typename T>
+    struct _is_span_compatible_container_impl<void_t<decltype(declval<C&>().data()), decltype(declval<C&>().size())>, C, T>
+        : is_convertible<remove_pointer_t<decltype(declval<C&>().data())>(*)[], T(*)[]>
+    {};
+
+    template<typename C, typename T>
+    constexpr auto _is_span_compatible_container_v = _is_span_compatible_container_impl<void_t<>, C, T>::value;
+
+    template<typename T, size_t Extent>
+    class span : private _span_extent<Extent>
+    {
+        using extent_base = _span_extent<Extent>;
+
+    public:
+        using element_type = T;
+        using value_type = remove_cv_t<T>;
+        using size_type = size_t;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = pointer;
+
+        static constexpr size_t extent = Extent;
+
+        template<size_t _ext = Extent, enable_if_t<_ext == 0 || _ext == dynamic_extent, int> = 0>
+        constexpr span() noexcept
+            :extent_base(0), m_pData(nullptr)
+        {}
+
+        constexpr span(pointer pData, size_type count)
+            :extent_base(count), m_pData(pData)
+        {
+            if constexpr (Extent != dynamic_extent)
+                if (count != Extent)
+                    verify(false, "span size does not match its extent");
+        }
+
+        constexpr span(pointer pFirst, pointer pLast)
+            :span(pFirst, static_cast<size_type>(pLast - pFirst))
+        {}
+
+        template<size_t _size, enable_if_t<Extent == dynamic_extent || Extent == _size, int> = 0>
+        constexpr span(element_type(&arr)[_size]) noexcept
+            :extent_base(_size), m_pData(arr)
+        {}
+
+        template<typename U, size_t _size, enable_if_t<(Extent == dynamic_extent || Extent == _size)
+            && is_convertible_v<U(*)[], T(*)[]>, int> = 0>
+        constexpr span(array<U, _size>& arr) noexcept
+            :extent_base(_size), m_pData(arr.data())
+        {}
+
+        template<typename U, size_t _size, enable_if_t<(Extent == dynamic_extent || Extent == _size)
+            && is_convertible_v<const U(*)[], T(*)[]>, int> = 0>
+        constexpr span(const array<U, _size>& arr) noexcept
+            :extent_base(_size), m_pData(arr.data())
+        {}
+
+        // any other contiguous container, only for dynamic extents
+        template<typename C, enable_if_t<Extent == dynamic_extent && !is_array_v<C>
+            && _is_span_compatible_container_v<C, T>, int> = 0>
+        constexpr span(C& container)
+            :extent_base(container.size()), m_pData(container.data())
+        {}
+
+        // span<T> to span<const T> and static to dynamic extent
+        template<typename U, size_t _ext, enable_if_t<(Extent == dynamic_extent || Extent == _ext)
+            && is_convertible_v<U(*)[], T(*)[]>, int> = 0>
+        constexpr span(const span<U, _ext>& other)
+            :span(other.data(), other.size())
+        {}
+
+        constexpr span(const span&) noexcept = default;
+        constexpr span& operator=(const span&) noexcept = default;
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return extent_base::size();
+        }
+
+        [[nodiscard]] constexpr size_type size_bytes() const noexcept
+        {
+            return size() * sizeof(T);
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] constexpr T& operator[](size_type idx) const
+        {
+#if _DEBUG
+            if (idx >= size())
+                verify(false, "span subscript out of range");
+#endif
+            return m_pData[idx];
+        }
+
+        [[nodiscard]] constexpr T& front() const noexcept
+        {
+            return m_pData[0];
+        }
+
+        [[nodiscard]] constexpr T& back() const noexcept
+        {
+            return m_pData[size() - 1];
+        }
+
+        [[nodiscard]] constexpr pointer data() const noexcept
+        {
+            return m_pData;
+        }
+
+        [[nodiscard]] constexpr iterator begin() const noexcept
+        {
+            return m_pData;
+        }
+
+        [[nodiscard]] constexpr iterator end() const noexcept
+        {
+            return m_pData + size();
+        }
+
+        template<size_t _count>
+        [[nodiscard]] constexpr span<T, _count> first() const
+        {
+            static_assert(Extent == dynamic_extent || _count <= Extent, "span::first beyond the extent");
+            if (_count > size())
+                verify(false, "span::first beyond the size");
+            return span<T, _count>(m_pData, _count);
+        }
+
+        [[nodiscard]] constexpr span<T> first(size_type count) const
+        {
+            if (count > size())
+                verify(false, "span::first beyond the size");
+            return span<T>(m_pData, count);
+        }
+
+        template<size_t _count>
+        [[nodiscard]] constexpr span<T, _count> last() const
+        {
+            static_assert(Extent == dynamic_extent || _count <= Extent, "span::last beyond the extent");
+            if (_count > size())
+                verify(false, "span::last beyond the size");
+            return span<T, _count>(m_pData + size() - _count, _count);
+        }
+
+        [[nodiscard]] constexpr span<T> last(size_type count) const
+        {
+            if (count > size())
+                verify(false, "span::last beyond the size");
+            return span<T>(m_pData + size() - count, count);
+        }
+
+        template<size_t _offset, size_t _count = dynamic_extent>
+        [[nodiscard]] constexpr auto subspan() const
+        {
+            static_assert(Extent == dynamic_extent || (_offset <= Extent
+                && (_count == dynamic_extent || _count <= Extent - _offset)), "span::subspan beyond the extent");
+            if (!(_offset <= size() && (_count == dynamic_extent || _count <= size() - _offset)))
+                verify(false, "span::subspan beyond the size");
+
+            constexpr auto resultExtent = _count != dynamic_extent ? _count
+                : (Extent != dynamic_extent ? Extent - _offset : dynamic_extent);
+            return span<T, resultExtent>(m_pData + _offset, _count != dynamic_extent ? _count : size() - _offset);
+        }
+
+        [[nodiscard]] constexpr span<T> subspan(size_type offset, size_type count = dynamic_extent) const
+        {
+            if (!(offset <= size() && (count == dynamic_extent || count <= size() - offset)))
+                verify(false, "span::subspan beyond the size");
+            return span<T>(m_pData + offset, count == dynamic_extent ? size() - offset : count);
+        }
+
+    private:
+        pointer m_pData;
+    };
+
+    template<typename T, size_t _size>
+    span(T(&)[_size]) -> span<T, _size>;
+
+    template<typename T, size_t _size>
+    span(array<T, _size>&) -> span<T, _size>;
+
+    template<typename T, size_t _size>
+    span(const array<T, _size>&) -> span<const T, _size>;
+
+    template<typename T>
+    span(T*, size_t) -> span<T>;
+
+    template<typename T, size_t Extent>
+    [[nodiscard]] span<const uint8_t, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T)> as_bytes(span<T, Extent> sp) noexcept
+    {
+        return { reinterpret_cast<const uint8_t*>(sp.data()), sp.size_bytes() };
+    }
+
+    template<typename T, size_t Extent, enable_if_t<!is_const_v<T>, int> = 0>
+    [[nodiscard]] span<uint8_t, Extent == dynamic_extent ? dynamic_extent : Extent * sizeof(T)> as_writable_bytes(span<T, Extent> sp) noexcept
+    {
+        return { reinterpret_cast<uint8_t*>(sp.data()), sp.size_bytes() };
+    }
+}
+#endif // ASTD_SPAN
\ No newline at end of file
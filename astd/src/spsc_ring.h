@@ -0,0 +1,210 @@
+#pragma once
+#ifndef ASTD_SPSC_RING
+#define ASTD_SPSC_RING
+#ifdef __AVR__
+#include <util/atomic.h>
+#endif // __AVR__
+#include "array.h"
+#include "type_traits.h"
+
+/*
+spsc_ring is not part of the STL. It is a lock free ring buffer for exactly one producer and one
+consumer, e.g. an ISR pushing received bytes and loop() popping them (or the other way around). The
+producer only writes the head index, the consumer only writes the tail index, so neither side needs
+to disable interrupts.
+
+_size has to be a power of two. Both indices run freely and are masked on access, which lets the ring
+use all _size slots. For _size <= 128 they are single bytes and thus read and written atomically
+on AVR. Wider indices are read with interrupts disabled there, on hosts all index accesses are
+acquire / release atomics.
+
+push_n / pop_n copy up to two contiguous spans at once (memcpy for trivially copyable T) and publish
+the new index only once, so bulk transfers cost one index update instead of one per element.
+*/
+
+namespace astd
+{
+    template<typename T, size_t _size>
+    class spsc_ring
+    {
+        static_assert(_size > 0 && (_size & (_size - 1)) == 0, "spsc_ring size has to be a power of two");
+
+    private:
+        using index_type = conditional_t<_size <= 0x80, uint8_t, conditional_t<_size <= 0x8000, uint16_t, size_t>>;
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+
+        spsc_ring() noexcept
+            :m_head(0), m_tail(0)
+        {}
+
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring& operator=(const spsc_ring&) = delete;
+
+        // producer side, returns false if the ring is full
+        bool push(const T& val) noexcept
+        {
+            const auto head = m_head;
+            if (static_cast<index_type>(head - load_acquire(m_tail)) == _size)
+                return false;
+
+            m_data[head & s_mask] = val;
+            store_release(m_head, static_cast<index_type>(head + 1));
+            return true;
+        }
+
+        bool push(T&& val) noexcept
+        {
+            const auto head = m_head;
+            if (static_cast<index_type>(head - load_acquire(m_tail)) == _size)
+                return false;
+
+            m_data[head & s_mask] = move(val);
+            store_release(m_head, static_cast<index_type>(head + 1));
+            return true;
+        }
+
+        // producer side, pushes as many of the count elements as fit and returns their number
+        size_type push_n(const T* pSrc, size_type count) noexcept
+        {
+            const auto head = m_head;
+            const auto space = _size - static_cast<index_type>(head - load_acquire(m_tail));
+            if (count > space)
+                count = space;
+
+            const auto first = head & s_mask;
+            const auto firstCount = count < _size - first ? count : _size - first;
+            copy_elements(m_data.data() + first, pSrc, firstCount);
+            copy_elements(m_data.data(), pSrc + firstCount, count - firstCount);
+            store_release(m_head, static_cast<index_type>(head + count));
+            return count;
+        }
+
+        // consumer side, returns false if the ring is empty
+        bool pop(T& val) noexcept
+        {
+            const auto tail = m_tail;
+            if (load_acquire(m_head) == tail)
+                return false;
+
+            val = move(m_data[tail & s_mask]);
+            store_release(m_tail, static_cast<index_type>(tail + 1));
+            return true;
+        }
+
+        // consumer side, pops up to count elements and returns their number
+        size_type pop_n(T* pDst, size_type count) noexcept
+        {
+            const auto tail = m_tail;
+            const size_type available = static_cast<index_type>(load_acquire(m_head) - tail);
+            if (count > available)
+                count = available;
+
+            const auto first = tail & s_mask;
+            const auto firstCount = count < _size - first ? count : _size - first;
+            copy_elements(pDst, m_data.data() + first, firstCount);
+            copy_elements(pDst + firstCount, m_data.data(), count - firstCount);
+            store_release(m_tail, static_cast<index_type>(tail + count));
+            return count;
+        }
+
+        // consumer side, the oldest element, the ring must not be empty
+        [[nodiscard]] const T& front() const noexcept
+        {
+            return m_data[m_tail & s_mask];
+        }
+
+        // consumer side, drops all elements pushed so far
+        void clear() noexcept
+        {
+            store_release(m_tail, load_acquire(m_head));
+        }
+
+        // a snapshot, exact only when called from one of the two sides
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return static_cast<index_type>(load_acquire(m_head) - load_acquire(m_tail));
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] bool full() const noexcept
+        {
+            return size() == _size;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept
+        {
+            return _size;
+        }
+
+    private:
+        static index_type load_acquire(const volatile index_type& idx) noexcept
+        {
+#ifdef __AVR__
+            if constexpr (sizeof(index_type) == 1)
+            {
+                const index_type ret = idx;
+                __asm__ __volatile__("" ::: "memory");
+                return ret;
+            }
+            else
+            {
+                index_type ret;
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                {
+                    ret = idx;
+                }
+                return ret;
+            }
+#else
+            return __atomic_load_n(&idx, __ATOMIC_ACQUIRE);
+#endif // __AVR__
+        }
+
+        static void store_release(volatile index_type& idx, index_type val) noexcept
+        {
+#ifdef __AVR__
+            __asm__ __volatile__("" ::: "memory");
+            if constexpr (sizeof(index_type) == 1)
+                idx = val;
+            else
+            {
+                ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+                {
+                    idx = val;
+                }
+            }
+#else
+            __atomic_store_n(&idx, val, __ATOMIC_RELEASE);
+#endif // __AVR__
+        }
+
+        static void copy_elements(T* pDst, const T* pSrc, size_type count) noexcept
+        {
+            if constexpr (is_trivially_copyable_v<T>)
+                memcpy(pDst, pSrc, sizeof(T) * count);
+            else
+                for (size_type idx = 0; idx < count; ++idx)
+                    pDst[idx] = pSrc[idx];
+        }
+
+        static constexpr size_t s_mask = _size - 1;
+#ifdef __AVR__
+        static constexpr size_t s_indexAlign = alignof(index_type);
+#else
+        // keeps the indices of producer and consumer on separate cache lines
+        static constexpr size_t s_indexAlign = 64;
+#endif // __AVR__
+
+        array<T, _size> m_data;
+        alignas(s_indexAlign) volatile index_type m_head;
+        alignas(s_indexAlign) volatile index_type m_tail;
+    };
+}
+#endif // ASTD_SPSC_RING
\ No newline at end of file
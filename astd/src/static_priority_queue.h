@@ -0,0 +1,229 @@
+#pragma once
+#ifndef ASTD_STATIC_PRIORITY_QUEUE
+#define ASTD_STATIC_PRIORITY_QUEUE
+#include "type_traits.h"
+#include "utility.h"
+#include "functional.h"
+#include "error.h"
+
+/*
+static_priority_queue is not part of the STL. It mirrors std::priority_queue with a fixed capacity
+and inline storage: top() is the largest element with respect to Compare, so greater<> turns it into
+a min queue, e.g. of deadlines. push and pop are O(log N), top is O(1) and nothing is allocated.
+
+Unlike std::priority_queue push returns a handle, which stays valid until the element is popped or
+erased. Through it the priority of a queued element can be changed (decrease-key) or the element can
+be removed in O(log N), e.g. when a pending timeout is rescheduled or cancelled.
+
+The elements stay in their slot while the heap is built of the slot indices, so moving an element
+up or down only moves one byte sized index below 255 elements. The heap array also serves as the
+stack of free handles behind the last heap entry. Slots of removed elements are reset to a default
+constructed T. No comparator object is stored, so Compare has to be default constructible.
+*/
+
+namespace astd
+{
+    template<typename T, size_t _capacity, typename Compare = less<T>>
+    class static_priority_queue
+    {
+        static_assert(_capacity > 0 && _capacity < 0xFFFF, "static_priority_queue needs a capacity between 1 and 65534");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using const_reference = const T&;
+        using value_compare = Compare;
+        using handle_type = conditional_t<_capacity < 0xFF, uint8_t, uint16_t>;
+
+        static constexpr handle_type npos = static_cast<handle_type>(-1);
+
+        static_priority_queue() noexcept
+            :m_slots(), m_size(0)
+        {
+            for (size_t idx = 0; idx < _capacity; ++idx)
+            {
+                m_heap[idx] = static_cast<handle_type>(idx);
+                m_pos[idx] = npos;
+            }
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] bool full() const noexcept
+        {
+            return m_size == _capacity;
+        }
+
+        [[nodiscard]] const T& top() const noexcept
+        {
+#if _DEBUG
+            verify(m_size > 0, "static_priority_queue::top on empty queue");
+#endif
+            return m_slots[m_heap[0]];
+        }
+
+        [[nodiscard]] handle_type top_handle() const noexcept
+        {
+            return m_size > 0 ? m_heap[0] : npos;
+        }
+
+        handle_type push(const T& val)
+        {
+            return emplace(val);
+        }
+
+        handle_type push(T&& val)
+        {
+            return emplace(astd::move(val));
+        }
+
+        template<typename... Args>
+        handle_type emplace(Args&&... args)
+        {
+            verify(m_size < _capacity, "static_priority_queue capacity exceeded");
+
+            const auto handle = m_heap[m_size];
+            m_slots[handle] = T(forward<Args>(args)...);
+            m_pos[handle] = m_size;
+            sift_up(m_size++);
+            return handle;
+        }
+
+        void pop()
+        {
+            verify(m_size > 0, "static_priority_queue::pop on empty queue");
+            erase(m_heap[0]);
+        }
+
+        [[nodiscard]] bool contains(handle_type handle) const noexcept
+        {
+            return handle < _capacity && m_pos[handle] != npos;
+        }
+
+        // the element queued with handle
+        [[nodiscard]] const T& operator[](handle_type handle) const noexcept
+        {
+#if _DEBUG
+            verify(contains(handle), "invalid static_priority_queue handle");
+#endif
+            return m_slots[handle];
+        }
+
+        // changes the priority of a queued element, moving it towards the top or the bottom as needed
+        void update(handle_type handle, const T& val)
+        {
+            verify(contains(handle), "invalid static_priority_queue handle");
+            m_slots[handle] = val;
+            restore(m_pos[handle]);
+        }
+
+        void update(handle_type handle, T&& val)
+        {
+            verify(contains(handle), "invalid static_priority_queue handle");
+            m_slots[handle] = astd::move(val);
+            restore(m_pos[handle]);
+        }
+
+        // removes a queued element, the handle becomes invalid
+        void erase(handle_type handle)
+        {
+            verify(m_size > 0 && contains(handle), "invalid static_priority_queue handle");
+
+            const auto pos = m_pos[handle];
+            --m_size;
+            if (pos != m_size)
+            {
+                place(pos, m_heap[m_size]);
+                restore(pos);
+            }
+
+            m_heap[m_size] = handle;
+            m_pos[handle] = npos;
+            m_slots[handle] = T();
+        }
+
+        void clear()
+        {
+            while (m_size > 0)
+            {
+                const auto handle = m_heap[--m_size];
+                m_pos[handle] = npos;
+                m_slots[handle] = T();
+            }
+        }
+
+    private:
+        void place(size_t pos, handle_type handle) noexcept
+        {
+            m_heap[pos] = handle;
+            m_pos[handle] = static_cast<handle_type>(pos);
+        }
+
+        void sift_up(size_t pos)
+        {
+            const auto handle = m_heap[pos];
+            while (pos > 0)
+            {
+                const auto parent = (pos - 1) / 2;
+                if (!Compare()(m_slots[m_heap[parent]], m_slots[handle]))
+                    break;
+
+                place(pos, m_heap[parent]);
+                pos = parent;
+            }
+            place(pos, handle);
+        }
+
+        void sift_down(size_t pos)
+        {
+            const auto handle = m_heap[pos];
+            // m_size never exceeds the capacity, bounding it by it lets the compiler prove the children in range
+            const size_t size = m_size < _capacity ? m_size : _capacity;
+            for (auto child = 2 * pos + 1; child < size; child = 2 * pos + 1)
+            {
+                if (child + 1 < size && Compare()(m_slots[m_heap[child]], m_slots[m_heap[child + 1]]))
+                    ++child;
+                if (!Compare()(m_slots[handle], m_slots[m_heap[child]]))
+                    break;
+
+                place(pos, m_heap[child]);
+                pos = child;
+            }
+            place(pos, handle);
+        }
+
+        // after the element at pos changed
+        void restore(size_t pos)
+        {
+            // a single element is always in order, this also keeps the compiler from seeing the
+            // parent and child indices out of the bounds of the one element arrays
+            if constexpr (_capacity == 1)
+                return;
+            else if (pos > 0 && Compare()(m_slots[m_heap[(pos - 1) / 2]], m_slots[m_heap[pos]]))
+                sift_up(pos);
+            else
+                sift_down(pos);
+        }
+
+        T m_slots[_capacity];
+        // the heap of handles in [0, m_size), the free handles behind it
+        handle_type m_heap[_capacity];
+        // position of each handle in m_heap, npos if it is not queued
+        handle_type m_pos[_capacity];
+        handle_type m_size;
+    };
+}
+#endif // ASTD_STATIC_PRIORITY_QUEUE
\ No newline at end of file
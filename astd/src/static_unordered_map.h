@@ -0,0 +1,403 @@
+#pragma once
+#ifndef ASTD_STATIC_UNORDERED_MAP
+#define ASTD_STATIC_UNORDERED_MAP
+#include "type_traits.h"
+#include "utility.h"
+#include "functional.h"
+#include "error.h"
+
+/*
+static_unordered_map is not part of the STL. It is a hash map with a fixed number of slots that live
+inline, so its memory use is known at compile time and it never touches the heap. Lookup, insert and
+erase are O(1) on average, also while the map is updated frequently.
+
+It uses open addressing with Robin Hood probing: on insertion an element that is further away from
+its home slot takes over the slot of one that is closer to its own. This keeps the probe sequences
+short and even, and a lookup can stop as soon as it meets an element closer to home than the key
+would be. Erasing shifts the following elements of the probe sequence back by one slot, so there are
+no tombstones and the map does not degrade over time.
+
+Next to the pair<K, V> slots there is one control byte per slot, which holds 0 for an empty slot and
+the probe distance plus one otherwise. Empty checks and the Robin Hood comparisons only read these
+bytes, the keys are only compared where the distance matches.
+
+_slots has to be a power of two. The map can be filled completely, but the probe sequences grow quickly
+above a load of about 80%. The hash is spread over the slots with a multiplicative (Fibonacci) mix, so
+the plain integer hashes of hash<T> work well for sequential ids.
+
+Differences to std::unordered_map:
+Every slot holds a default constructed pair, erased slots are reset to one.
+The key of value_type is not const, modifying it through an iterator breaks the map.
+Iterators are invalidated by every insert and erase, erase(iterator) returns nothing.
+No hasher or key_equal objects are stored, so both have to be default constructible.
+*/
+
+namespace astd
+{
+    template<typename K, typename V, size_t _slots, typename Hash = hash<K>, typename KeyEqual = equal_to<K>>
+    class static_unordered_map
+    {
+        static_assert(_slots > 0 && (_slots & (_slots - 1)) == 0, "static_unordered_map needs a power of two number of slots");
+
+    private:
+        using stored_size_type = conditional_t<_slots <= 0xFF, uint8_t, size_t>;
+
+        static constexpr size_t s_mask = _slots - 1;
+        static constexpr size_t s_npos = _slots;
+        static constexpr uint8_t s_maxDistance = 0xFF;
+
+        [[nodiscard]] static constexpr int slot_bits() noexcept
+        {
+            int bits = 0;
+            for (auto slots = _slots; slots > 1; slots >>= 1)
+                ++bits;
+            return bits;
+        }
+
+        // 2^digits / golden ratio, an odd factor whose high product bits depend on all key bits
+        static constexpr size_t s_golden = sizeof(size_t) >= 8 ? static_cast<size_t>(0x9E3779B97F4A7C15ULL)
+            : (sizeof(size_t) >= 4 ? static_cast<size_t>(0x9E3779B9UL) : static_cast<size_t>(0x9E37U));
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = pair<K, V>;
+        using size_type = size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        template<bool _is_const>
+        class _iterator
+        {
+            using map_pointer = conditional_t<_is_const, const static_unordered_map*, static_unordered_map*>;
+
+        public:
+            using value_type = pair<K, V>;
+            using difference_type = ptrdiff_t;
+            using reference = conditional_t<_is_const, const value_type&, value_type&>;
+            using pointer = conditional_t<_is_const, const value_type*, value_type*>;
+
+            constexpr _iterator() noexcept
+                :m_pMap(nullptr), m_idx(0)
+            {}
+
+            constexpr _iterator(map_pointer pMap, size_t idx) noexcept
+                :m_pMap(pMap), m_idx(idx)
+            {
+                skip_empty();
+            }
+
+            // iterator to const_iterator
+            template<bool _other_const, enable_if_t<_is_const && !_other_const, int> = 0>
+            constexpr _iterator(const _iterator<_other_const>& other) noexcept
+                :m_pMap(other.m_pMap), m_idx(other.m_idx)
+            {}
+
+            [[nodiscard]] constexpr reference operator*() const noexcept
+            {
+                return m_pMap->m_slots[m_idx];
+            }
+
+            [[nodiscard]] constexpr pointer operator->() const noexcept
+            {
+                return m_pMap->m_slots + m_idx;
+            }
+
+            constexpr _iterator& operator++() noexcept
+            {
+                ++m_idx;
+                skip_empty();
+                return *this;
+            }
+
+            constexpr _iterator operator++(int) noexcept
+            {
+                auto ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+            [[nodiscard]] constexpr bool operator==(const _iterator& other) const noexcept
+            {
+                return m_idx == other.m_idx;
+            }
+
+            [[nodiscard]] constexpr bool operator!=(const _iterator& other) const noexcept
+            {
+                return m_idx != other.m_idx;
+            }
+
+        private:
+            friend class static_unordered_map;
+            friend class _iterator<!_is_const>;
+
+            constexpr void skip_empty() noexcept
+            {
+                while (m_idx < _slots && m_pMap->m_ctrl[m_idx] == 0)
+                    ++m_idx;
+            }
+
+            map_pointer m_pMap;
+            size_t m_idx;
+        };
+
+        using iterator = _iterator<false>;
+        using const_iterator = _iterator<true>;
+
+        constexpr static_unordered_map() noexcept
+            :m_slots(), m_ctrl(), m_size(0)
+        {}
+
+        [[nodiscard]] constexpr iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        [[nodiscard]] constexpr const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        [[nodiscard]] constexpr iterator end() noexcept
+        {
+            return iterator(this, _slots);
+        }
+
+        [[nodiscard]] constexpr const_iterator end() const noexcept
+        {
+            return const_iterator(this, _slots);
+        }
+
+        [[nodiscard]] constexpr const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        [[nodiscard]] constexpr const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        [[nodiscard]] constexpr size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return _slots;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr bool full() const noexcept
+        {
+            return m_size == _slots;
+        }
+
+        [[nodiscard]] constexpr float load_factor() const noexcept
+        {
+            return static_cast<float>(m_size) / _slots;
+        }
+
+        void clear()
+        {
+            for (size_t idx = 0; idx < _slots; ++idx)
+            {
+                if (m_ctrl[idx] != 0)
+                {
+                    m_slots[idx] = value_type();
+                    m_ctrl[idx] = 0;
+                }
+            }
+            m_size = 0;
+        }
+
+        [[nodiscard]] iterator find(const key_type& key)
+        {
+            return iterator(this, find_idx(key));
+        }
+
+        [[nodiscard]] const_iterator find(const key_type& key) const
+        {
+            return const_iterator(this, find_idx(key));
+        }
+
+        [[nodiscard]] bool contains(const key_type& key) const
+        {
+            return find_idx(key) != s_npos;
+        }
+
+        [[nodiscard]] size_type count(const key_type& key) const
+        {
+            return contains(key) ? 1 : 0;
+        }
+
+        [[nodiscard]] V& at(const key_type& key)
+        {
+            const auto idx = find_idx(key);
+            verify(idx != s_npos, "static_unordered_map key not found");
+            return m_slots[idx].second;
+        }
+
+        [[nodiscard]] const V& at(const key_type& key) const
+        {
+            const auto idx = find_idx(key);
+            verify(idx != s_npos, "static_unordered_map key not found");
+            return m_slots[idx].second;
+        }
+
+        // inserts a default constructed value if key is not contained
+        V& operator[](const key_type& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        pair<iterator, bool> insert(const value_type& val)
+        {
+            const auto idx = find_idx(val.first);
+            if (idx != s_npos)
+                return pair<iterator, bool>(iterator(this, idx), false);
+
+            return pair<iterator, bool>(iterator(this, insert_new(value_type(val))), true);
+        }
+
+        pair<iterator, bool> insert(value_type&& val)
+        {
+            const auto idx = find_idx(val.first);
+            if (idx != s_npos)
+                return pair<iterator, bool>(iterator(this, idx), false);
+
+            return pair<iterator, bool>(iterator(this, insert_new(astd::move(val))), true);
+        }
+
+        // constructs the value from args only if key is not contained yet
+        template<typename... Args>
+        pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        {
+            const auto idx = find_idx(key);
+            if (idx != s_npos)
+                return pair<iterator, bool>(iterator(this, idx), false);
+
+            return pair<iterator, bool>(iterator(this, insert_new(value_type(key, V(forward<Args>(args)...)))), true);
+        }
+
+        template<typename M>
+        pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+        {
+            const auto idx = find_idx(key);
+            if (idx != s_npos)
+            {
+                m_slots[idx].second = forward<M>(obj);
+                return pair<iterator, bool>(iterator(this, idx), false);
+            }
+
+            return pair<iterator, bool>(iterator(this, insert_new(value_type(key, forward<M>(obj)))), true);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            const auto idx = find_idx(key);
+            if (idx == s_npos)
+                return 0;
+
+            erase_at(idx);
+            return 1;
+        }
+
+        void erase(const_iterator pos)
+        {
+            erase_at(pos.m_idx);
+        }
+
+    private:
+        [[nodiscard]] static size_t home_idx(const key_type& key) noexcept
+        {
+            const auto hash = static_cast<size_t>(Hash()(key));
+            if constexpr (_slots == 1)
+                return 0;
+            else
+                return static_cast<size_t>(hash * s_golden) >> (sizeof(size_t) * 8 - slot_bits());
+        }
+
+        // s_npos if key is not contained
+        [[nodiscard]] size_t find_idx(const key_type& key) const
+        {
+            auto idx = home_idx(key);
+            for (unsigned distance = 1; distance <= s_maxDistance; ++distance)
+            {
+                const auto ctrl = m_ctrl[idx];
+                // an empty slot or an element closer to its home ends the probe sequence of key
+                if (ctrl < distance)
+                    return s_npos;
+                if (ctrl == distance && KeyEqual()(m_slots[idx].first, key))
+                    return idx;
+
+                idx = (idx + 1) & s_mask;
+            }
+            return s_npos;
+        }
+
+        // val must not be contained yet, returns its slot
+        size_t insert_new(value_type&& val)
+        {
+            verify(m_size < _slots, "static_unordered_map capacity exceeded");
+
+            auto entry = astd::move(val);
+            auto idx = home_idx(entry.first);
+            auto result = s_npos;
+            for (unsigned distance = 1; ; ++distance)
+            {
+                verify(distance <= s_maxDistance, "static_unordered_map probe sequence too long");
+
+                const auto ctrl = m_ctrl[idx];
+                if (ctrl == 0)
+                {
+                    m_slots[idx] = astd::move(entry);
+                    m_ctrl[idx] = static_cast<uint8_t>(distance);
+                    ++m_size;
+                    return result != s_npos ? result : idx;
+                }
+
+                // robin hood, the element closer to its home moves on
+                if (ctrl < distance)
+                {
+                    astd::swap(entry, m_slots[idx]);
+                    m_ctrl[idx] = static_cast<uint8_t>(distance);
+                    distance = ctrl;
+                    if (result == s_npos)
+                        result = idx;
+                }
+
+                idx = (idx + 1) & s_mask;
+            }
+        }
+
+        // backward shift deletion, pulls the rest of the probe sequence one slot closer to home
+        void erase_at(size_t idx)
+        {
+            auto next = (idx + 1) & s_mask;
+            while (m_ctrl[next] > 1)
+            {
+                m_slots[idx] = astd::move(m_slots[next]);
+                m_ctrl[idx] = static_cast<uint8_t>(m_ctrl[next] - 1);
+                idx = next;
+                next = (next + 1) & s_mask;
+            }
+
+            m_slots[idx] = value_type();
+            m_ctrl[idx] = 0;
+            --m_size;
+        }
+
+        value_type m_slots[_slots];
+        uint8_t m_ctrl[_slots];
+        stored_size_type m_size;
+    };
+}
+#endif // ASTD_STATIC_UNORDERED_MAP
\ No newline at end of file
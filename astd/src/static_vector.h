@@ -0,0 +1,398 @@
+#pragma once
+#ifndef ASTD_STATIC_VECTOR
+#define ASTD_STATIC_VECTOR
+#include <new.h> // placement new of the avr core
+#include "type_traits.h"
+#include "error.h"
+
+/*
+static_vector is not part of the STL (it mirrors boost::container::static_vector). It is a vector with a
+fixed capacity whose elements live inline in uninitialized storage, so it never touches the heap and
+can replace size-plus-array pairs as well as String or new[] buffers that would fragment it.
+
+Elements are constructed on insertion and destroyed on removal like in std::vector. For trivially
+copyable T copies and the shifting in insert / erase are done with memcpy / memmove. Exceeding the
+capacity is reported through verify.
+
+The size is stored in a uint8_t if _capacity fits into one.
+*/
+
+namespace astd
+{
+    template<typename T, size_t _capacity>
+    class static_vector
+    {
+        static_assert(_capacity > 0, "static_vector needs a capacity of at least one");
+
+    private:
+        using stored_size_type = conditional_t<_capacity <= 0xFF, uint8_t, size_t>;
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using reference = T&;
+        using const_reference = const T&;
+        using iterator = pointer;
+        using const_iterator = const_pointer;
+
+        static_vector() noexcept
+            :m_size(0)
+        {}
+
+        static_vector(size_type count, const T& val)
+            :m_size(0)
+        {
+            verify(count <= _capacity, "static_vector capacity exceeded");
+            for (; m_size < count; ++m_size)
+                new (data() + m_size) T(val);
+        }
+
+        static_vector(const static_vector& other)
+            :m_size(0)
+        {
+            copy_from(other);
+        }
+
+        static_vector(static_vector&& other)
+            :m_size(0)
+        {
+            move_from(other);
+        }
+
+        ~static_vector()
+        {
+            clear();
+        }
+
+        static_vector& operator=(const static_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                copy_from(other);
+            }
+            return *this;
+        }
+
+        static_vector& operator=(static_vector&& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                move_from(other);
+            }
+            return *this;
+        }
+
+        [[nodiscard]] T& at(size_t idx)
+        {
+            verify(idx < m_size, "invalid static_vector index");
+            return data()[idx];
+        }
+
+        [[nodiscard]] const T& at(size_t idx) const
+        {
+            verify(idx < m_size, "invalid static_vector index");
+            return data()[idx];
+        }
+
+        [[nodiscard]] T& operator[](size_t idx) noexcept
+        {
+#if _DEBUG
+            verify(idx < m_size, "static_vector subscription out of range");
+#endif
+            return data()[idx];
+        }
+
+        [[nodiscard]] const T& operator[](size_t idx) const noexcept
+        {
+#if _DEBUG
+            verify(idx < m_size, "static_vector subscription out of range");
+#endif
+            return data()[idx];
+        }
+
+        [[nodiscard]] T& front() noexcept
+        {
+            return data()[0];
+        }
+
+        [[nodiscard]] const T& front() const noexcept
+        {
+            return data()[0];
+        }
+
+        [[nodiscard]] T& back() noexcept
+        {
+            return data()[m_size - 1];
+        }
+
+        [[nodiscard]] const T& back() const noexcept
+        {
+            return data()[m_size - 1];
+        }
+
+        [[nodiscard]] T* data() noexcept
+        {
+            return reinterpret_cast<T*>(m_storage);
+        }
+
+        [[nodiscard]] const T* data() const noexcept
+        {
+            return reinterpret_cast<const T*>(m_storage);
+        }
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+            return data();
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return data() + m_size;
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return data() + m_size;
+        }
+
+        [[nodiscard]] const_iterator cbegin() const noexcept
+        {
+            return data();
+        }
+
+        [[nodiscard]] const_iterator cend() const noexcept
+        {
+            return data() + m_size;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return m_size == 0;
+        }
+
+        // not part of std::vector
+        [[nodiscard]] bool full() const noexcept
+        {
+            return m_size == _capacity;
+        }
+
+        [[nodiscard]] size_type size() const noexcept
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_type max_size() const noexcept
+        {
+            return _capacity;
+        }
+
+        [[nodiscard]] constexpr size_type capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        void clear() noexcept
+        {
+            destroy_tail(0);
+        }
+
+        void push_back(const T& val)
+        {
+            emplace_back(val);
+        }
+
+        void push_back(T&& val)
+        {
+            emplace_back(move(val));
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            verify(m_size < _capacity, "static_vector capacity exceeded");
+            auto* pElem = new (data() + m_size) T(forward<Args>(args)...);
+            ++m_size;
+            return *pElem;
+        }
+
+        void pop_back() noexcept
+        {
+#if _DEBUG
+            verify(m_size > 0, "pop_back on empty static_vector");
+#endif
+            destroy_tail(m_size - 1);
+        }
+
+        iterator insert(const_iterator pos, const T& val)
+        {
+            return emplace(pos, val);
+        }
+
+        iterator insert(const_iterator pos, T&& val)
+        {
+            return emplace(pos, move(val));
+        }
+
+        iterator insert(const_iterator pos, size_type count, const T& val)
+        {
+            const auto idx = static_cast<size_t>(pos - data());
+            verify(count <= _capacity - m_size, "static_vector capacity exceeded");
+            if (count == 0)
+                return data() + idx;
+
+            // val may refer to an element that is about to be shifted
+            const T copy(val);
+            open_gap(idx, count);
+            for (size_t offset = 0; offset < count; ++offset)
+                new (data() + idx + offset) T(copy);
+            m_size = static_cast<stored_size_type>(m_size + count);
+            return data() + idx;
+        }
+
+        template<typename... Args>
+        iterator emplace(const_iterator pos, Args&&... args)
+        {
+            const auto idx = static_cast<size_t>(pos - data());
+            verify(m_size < _capacity, "static_vector capacity exceeded");
+            if (idx == m_size)
+            {
+                emplace_back(forward<Args>(args)...);
+                return data() + idx;
+            }
+
+            // args may refer to an element that is about to be shifted
+            T val(forward<Args>(args)...);
+            open_gap(idx, 1);
+            new (data() + idx) T(move(val));
+            ++m_size;
+            return data() + idx;
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            const auto idx = static_cast<size_t>(first - data());
+            const auto count = static_cast<size_t>(last - first);
+            if (count == 0)
+                return data() + idx;
+
+            if constexpr (is_trivially_copyable_v<T>)
+            {
+                memmove(data() + idx, data() + idx + count, sizeof(T) * (m_size - idx - count));
+                m_size = static_cast<stored_size_type>(m_size - count);
+            }
+            else
+            {
+                for (size_t dst = idx; dst + count < m_size; ++dst)
+                    data()[dst] = move(data()[dst + count]);
+                destroy_tail(m_size - count);
+            }
+            return data() + idx;
+        }
+
+        void resize(size_type count)
+        {
+            verify(count <= _capacity, "static_vector capacity exceeded");
+            if (count < m_size)
+                destroy_tail(count);
+            else
+                for (; m_size < count; ++m_size)
+                    new (data() + m_size) T();
+        }
+
+        void resize(size_type count, const T& val)
+        {
+            verify(count <= _capacity, "static_vector capacity exceeded");
+            if (count < m_size)
+                destroy_tail(count);
+            else
+                for (; m_size < count; ++m_size)
+                    new (data() + m_size) T(val);
+        }
+
+        [[nodiscard]] bool operator==(const static_vector& other) const
+        {
+            if (m_size != other.m_size)
+                return false;
+
+            for (size_t idx = 0; idx < m_size; ++idx)
+                if (!(data()[idx] == other.data()[idx]))
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] bool operator!=(const static_vector& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        void copy_from(const static_vector& other)
+        {
+            if constexpr (is_trivially_copyable_v<T>)
+            {
+                memcpy(m_storage, other.m_storage, sizeof(T) * other.m_size);
+                m_size = other.m_size;
+            }
+            else
+                for (; m_size < other.m_size; ++m_size)
+                    new (data() + m_size) T(other.data()[m_size]);
+        }
+
+        // leaves other in a valid but unspecified state as the moved from elements stay alive
+        void move_from(static_vector& other)
+        {
+            if constexpr (is_trivially_copyable_v<T>)
+            {
+                memcpy(m_storage, other.m_storage, sizeof(T) * other.m_size);
+                m_size = other.m_size;
+            }
+            else
+                for (; m_size < other.m_size; ++m_size)
+                    new (data() + m_size) T(move(other.data()[m_size]));
+        }
+
+        // moves [idx, size()) count slots back, the slots [idx, idx + count) are uninitialized afterwards
+        void open_gap(size_t idx, size_t count)
+        {
+            if constexpr (is_trivially_copyable_v<T>)
+                memmove(data() + idx + count, data() + idx, sizeof(T) * (m_size - idx));
+            else
+            {
+                for (size_t src = m_size; src > idx; --src)
+                {
+                    auto* pSrc = data() + src - 1;
+                    new (pSrc + count) T(move(*pSrc));
+                    pSrc->~T();
+                }
+            }
+        }
+
+        void destroy_tail(size_t newSize) noexcept
+        {
+            if constexpr (!is_trivially_destructible_v<T>)
+                for (size_t idx = newSize; idx < m_size; ++idx)
+                    data()[idx].~T();
+
+            m_size = static_cast<stored_size_type>(newSize);
+        }
+
+        alignas(T) unsigned char m_storage[sizeof(T) * _capacity];
+        stored_size_type m_size;
+    };
+}
+#endif // ASTD_STATIC_VECTOR
\ No newline at end of file
@@ -2,6 +2,14 @@
 #ifndef ASTD_TYPETRAITS
 #define ASTD_TYPETRAITS
 
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define ASTD_HAS_CONSTANT_EVALUATED 1
+#endif
+#elif defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#define ASTD_HAS_CONSTANT_EVALUATED 1
+#endif
+
 namespace astd
 {
     template<typename T, T val>
@@ -200,6 +208,39 @@ namespace astd
     template<typename T>
     constexpr auto is_move_assignable_v = is_move_assignable<T>::value;
 
+    // the trivial traits can not be implemented in the language, GCC and clang provide them as builtins
+    template<typename T>
+    struct is_trivially_copyable : bool_constant<__is_trivially_copyable(T)>
+    {};
+
+    template<typename T>
+    constexpr auto is_trivially_copyable_v = is_trivially_copyable<T>::value;
+
+    template<typename T>
+    struct is_trivially_destructible : bool_constant<__has_trivial_destructor(T)>
+    {};
+
+    template<typename T>
+    constexpr auto is_trivially_destructible_v = is_trivially_destructible<T>::value;
+
+    template<typename T>
+    struct is_enum : bool_constant<__is_enum(T)>
+    {};
+
+    template<typename T>
+    constexpr auto is_enum_v = is_enum<T>::value;
+
+    // true while the compiler evaluates a constant expression, lets constexpr functions take a memcpy or
+    // intrinsic path at run time. Always false on compilers without the builtin (GCC < 9)
+    [[nodiscard]] constexpr bool is_constant_evaluated() noexcept
+    {
+#ifdef ASTD_HAS_CONSTANT_EVALUATED
+        return __builtin_is_constant_evaluated();
+#else
+        return false;
+#endif // ASTD_HAS_CONSTANT_EVALUATED
+    }
+
     // Predeclarations for is_swappable implementations
     template<typename T, enable_if_t<is_move_constructible_v<T>&& is_move_assignable_v<T>, int> = 0>
     constexpr void swap(T& lhs, T& rhs) noexcept;
@@ -284,6 +325,17 @@ namespace astd
     template<typename T>
     constexpr auto is_reference_v = is_reference<T>::value;
 
+    template<typename T>
+    struct is_lvalue_reference : false_type
+    {};
+
+    template<typename T>
+    struct is_lvalue_reference<T&> : true_type
+    {};
+
+    template<typename T>
+    constexpr auto is_lvalue_reference_v = is_lvalue_reference<T>::value;
+
     template<typename T>
     struct is_function : bool_constant<!is_const_v<const T> && !is_reference_v<T>>
     {};
@@ -403,6 +455,36 @@ namespace astd
     template<typename T>
     constexpr auto is_pointer_t = is_pointer<T>::value;
 
+    template<typename T>
+    constexpr auto is_pointer_v = is_pointer<T>::value;
+
+    template<typename T>
+    struct _is_integral_impl : false_type
+    {};
+
+    template<> struct _is_integral_impl<bool> : true_type {};
+    template<> struct _is_integral_impl<char> : true_type {};
+    template<> struct _is_integral_impl<signed char> : true_type {};
+    template<> struct _is_integral_impl<unsigned char> : true_type {};
+    template<> struct _is_integral_impl<char16_t> : true_type {};
+    template<> struct _is_integral_impl<char32_t> : true_type {};
+    template<> struct _is_integral_impl<wchar_t> : true_type {};
+    template<> struct _is_integral_impl<short> : true_type {};
+    template<> struct _is_integral_impl<unsigned short> : true_type {};
+    template<> struct _is_integral_impl<int> : true_type {};
+    template<> struct _is_integral_impl<unsigned int> : true_type {};
+    template<> struct _is_integral_impl<long> : true_type {};
+    template<> struct _is_integral_impl<unsigned long> : true_type {};
+    template<> struct _is_integral_impl<long long> : true_type {};
+    template<> struct _is_integral_impl<unsigned long long> : true_type {};
+
+    template<typename T>
+    struct is_integral : _is_integral_impl<remove_cv_t<T>>
+    {};
+
+    template<typename T>
+    constexpr auto is_integral_v = is_integral<T>::value;
+
     template<typename, typename From, typename To>
     struct is_nonvoid_convertible_impl : false_type
     {};
@@ -3,21 +3,16 @@
 #define ASTD_UTILITY
 
 #include "type_traits.h"
+#include "algorithm.h"
 
 namespace astd
 {
-    template<typename FwdIt1, typename FwdIt2>
-    constexpr void iter_swap(FwdIt1 lhs, FwdIt2 rhs)
-    {
-        swap(*lhs, *rhs);
-    }
-
     template<typename T, enable_if_t<is_move_constructible_v<T> && is_move_assignable_v<T>, int> is_enabled>
     constexpr void swap(T& lhs, T& rhs) noexcept
     {
         auto temp = move(lhs);
         lhs = move(rhs);
-        rhs = move(lhs);
+        rhs = move(temp);
     }
 
     template<typename T, size_t _size, enable_if_t<is_swappable<T>::value, int> is_enabled>
@@ -25,13 +20,59 @@ namespace astd
     {
         if (&lhs == &rhs)
             return;
-        auto* begin = lhs;
-        const auto* end = begin + _size;
-        for (auto* rbegin = rhs; begin < end; ++begin, ++rbegin)
+        astd::swap_ranges(lhs, lhs + _size, rhs);
+    }
+
+    template<typename T, T... vals>
+    struct integer_sequence
+    {
+        using value_type = T;
+
+        [[nodiscard]] static constexpr size_t size() noexcept
         {
-            iter_swap(begin, rbegin);
+            return sizeof...(vals);
         }
-    }
+    };
+
+    template<size_t... vals>
+    using index_sequence = integer_sequence<size_t, vals...>;
+
+    template<typename Lhs, typename Rhs>
+    struct _concat_integer_sequence;
+
+    template<typename T, T... lhs, T... rhs>
+    struct _concat_integer_sequence<integer_sequence<T, lhs...>, integer_sequence<T, rhs...>>
+    {
+        using type = integer_sequence<T, lhs..., static_cast<T>(sizeof...(lhs) + rhs)...>;
+    };
+
+    // splits in halves, so the instantiation depth is logarithmic in _count
+    template<typename T, size_t _count>
+    struct _make_integer_sequence_impl
+        : _concat_integer_sequence<typename _make_integer_sequence_impl<T, _count / 2>::type,
+            typename _make_integer_sequence_impl<T, _count - _count / 2>::type>
+    {};
+
+    template<typename T>
+    struct _make_integer_sequence_impl<T, 0>
+    {
+        using type = integer_sequence<T>;
+    };
+
+    template<typename T>
+    struct _make_integer_sequence_impl<T, 1>
+    {
+        using type = integer_sequence<T, 0>;
+    };
+
+    template<typename T, T _count>
+    using make_integer_sequence = typename _make_integer_sequence_impl<T, static_cast<size_t>(_count)>::type;
+
+    template<size_t _count>
+    using make_index_sequence = make_integer_sequence<size_t, _count>;
+
+    template<typename... Ts>
+    using index_sequence_for = make_index_sequence<sizeof...(Ts)>;
 
     struct _noCopyMove_t
     {
@@ -59,13 +100,13 @@ namespace astd
 
         // TODO explicit overload
         template<typename U1 = T2, typename U2 = T2, enable_if_t<conjunction<is_copy_constructible<U1>, is_copy_constructible<U2>>::value, int> = 0>
-        pair(const T1& t1, const T2& t2)
+        constexpr pair(const T1& t1, const T2& t2)
             : first(t1), second(t2)
         {}
 
         // TODO explicit overload
         template<typename U1, typename U2, enable_if_t<conjunction<is_constructible<T1, U1&&>, is_constructible<T2, U2&&>>::value, int> = 0>
-        pair(U1&& u1, U2&& u2)
+        constexpr pair(U1&& u1, U2&& u2)
             : first(forward<U1>(u1)), second(forward<U2>(u2))
         {}
 
@@ -86,7 +127,7 @@ namespace astd
         constexpr pair(const pair& other) = default;
         constexpr pair(pair&& other) = default;
 
-        pair& operator=(typename conditional<conjunction<is_copy_assignable<T1>, is_copy_assignable<T2>>::value,
+        constexpr pair& operator=(typename conditional<conjunction<is_copy_assignable<T1>, is_copy_assignable<T2>>::value,
             const pair&, _noCopyMove_t&>::type other)
         {
             first = other.first;
@@ -103,7 +144,7 @@ namespace astd
         }
 
         // TODO noexcept with is_nothrow_move_assignable
-        pair& operator=(typename conditional<conjunction<is_move_assignable<T1>, is_move_assignable<T2>>::value,
+        constexpr pair& operator=(typename conditional<conjunction<is_move_assignable<T1>, is_move_assignable<T2>>::value,
             pair&&, _noCopyMove_t&&>::type other) noexcept
         {
             first = forward<T1>(other.first);
@@ -162,7 +203,7 @@ namespace astd
 
     // TODO, refactor when reference_wrapper is implemented
     template<typename T1, typename T2>
-    pair<decay_t<T1>, decay_t<T2>> make_pair(T1&& t1, T2&& t2)
+    constexpr pair<decay_t<T1>, decay_t<T2>> make_pair(T1&& t1, T2&& t2)
     {
         return pair<decay_t<T1>, decay_t<T2>>(forward<T1>(t1), forward<T2>(t2));
     }
@@ -0,0 +1,397 @@
+#pragma once
+#ifndef ASTD_WIDE_UINT
+#define ASTD_WIDE_UINT
+#include "bitset.h"
+#include "type_traits.h"
+
+/*
+wide_uint is not part of the STL. It is an unsigned integer of _bits bits with modulo 2^_bits
+arithmetic, meant for hashes, counters and CRCs of 64 to 256 bits. The value is stored exactly like
+bitset<_bits> stores its bits (least significant word first), so converting between the two is a copy.
+
+On AVR, addition and subtraction run as a single adc / sbc loop over the bytes of the value and
+multiplication works on bytes using the hardware 8x8 multiplier. Other targets use the word type of
+bitset for add / sub and 32 bit limbs with 64 bit products for multiplication.
+*/
+
+namespace astd
+{
+    template<size_t _bits>
+    class wide_uint
+    {
+        static_assert(_bits > 0, "wide_uint needs at least one bit");
+
+    private:
+        using word_type = _bitset_access::word_type<_bits>;
+
+#ifdef __AVR__
+        using limb_type = uint8_t;
+        using wide_limb_type = uint16_t;
+#else
+        using limb_type = uint32_t;
+        using wide_limb_type = uint64_t;
+#endif // __AVR__
+
+    public:
+        constexpr wide_uint() noexcept
+            :m_data{}
+        {}
+
+        constexpr wide_uint(unsigned long long val) noexcept
+            :m_data{}
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize && dataIdx * s_bitsInWord < 8 * sizeof(val); ++dataIdx)
+                m_data[dataIdx] = static_cast<word_type>(val >> (dataIdx * s_bitsInWord));
+            sanatize_trail();
+        }
+
+        explicit wide_uint(const bitset<_bits>& bits) noexcept
+        {
+            memcpy(m_data, _bitset_access::words(bits), sizeof(m_data));
+        }
+
+        [[nodiscard]] bitset<_bits> to_bitset() const noexcept
+        {
+            bitset<_bits> ret;
+            memcpy(_bitset_access::words(ret), m_data, sizeof(m_data));
+            return ret;
+        }
+
+        // the lowest 64 bits
+        [[nodiscard]] constexpr unsigned long long to_ullong() const noexcept
+        {
+            unsigned long long ret = 0;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize && dataIdx * s_bitsInWord < 8 * sizeof(ret); ++dataIdx)
+                ret |= static_cast<unsigned long long>(m_data[dataIdx]) << (dataIdx * s_bitsInWord);
+            return ret;
+        }
+
+        [[nodiscard]] constexpr explicit operator bool() const noexcept
+        {
+            for (const auto word : m_data)
+                if (word != 0)
+                    return true;
+
+            return false;
+        }
+
+        // adds other and returns the carry out of the most significant bit
+        bool add(const wide_uint& other) noexcept
+        {
+#ifdef __AVR__
+            if constexpr (sizeof(m_data) < 256)
+                return finish_carry(avr_add(reinterpret_cast<uint8_t*>(m_data), reinterpret_cast<const uint8_t*>(other.m_data)));
+#endif // __AVR__
+            bool carry = false;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+            {
+                word_type sum;
+                const bool carry1 = __builtin_add_overflow(m_data[dataIdx], other.m_data[dataIdx], &sum);
+                const bool carry2 = __builtin_add_overflow(sum, static_cast<word_type>(carry), &m_data[dataIdx]);
+                carry = carry1 || carry2;
+            }
+            return finish_carry(carry);
+        }
+
+        // subtracts other and returns the borrow out of the most significant bit
+        bool sub(const wide_uint& other) noexcept
+        {
+#ifdef __AVR__
+            if constexpr (sizeof(m_data) < 256)
+                return finish_carry(avr_sub(reinterpret_cast<uint8_t*>(m_data), reinterpret_cast<const uint8_t*>(other.m_data)));
+#endif // __AVR__
+            bool borrow = false;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+            {
+                word_type diff;
+                const bool borrow1 = __builtin_sub_overflow(m_data[dataIdx], other.m_data[dataIdx], &diff);
+                const bool borrow2 = __builtin_sub_overflow(diff, static_cast<word_type>(borrow), &m_data[dataIdx]);
+                borrow = borrow1 || borrow2;
+            }
+            return finish_carry(borrow);
+        }
+
+        wide_uint& operator+=(const wide_uint& other) noexcept
+        {
+            add(other);
+            return *this;
+        }
+
+        wide_uint& operator-=(const wide_uint& other) noexcept
+        {
+            sub(other);
+            return *this;
+        }
+
+        wide_uint& operator*=(const wide_uint& other) noexcept
+        {
+            // schoolbook multiplication, only the limbs below _bits are computed
+            limb_type result[s_limbCount] = {};
+            for (size_t lhsIdx = 0; lhsIdx < s_limbCount; ++lhsIdx)
+            {
+                const auto lhs = static_cast<wide_limb_type>(limb(lhsIdx));
+                if (lhs == 0)
+                    continue;
+
+                limb_type carry = 0;
+                for (size_t rhsIdx = 0; lhsIdx + rhsIdx < s_limbCount; ++rhsIdx)
+                {
+                    const auto product = lhs * other.limb(rhsIdx) + result[lhsIdx + rhsIdx] + carry;
+                    result[lhsIdx + rhsIdx] = static_cast<limb_type>(product);
+                    carry = static_cast<limb_type>(product >> s_bitsInLimb);
+                }
+            }
+
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+            {
+                word_type word = 0;
+                for (size_t part = 0; part < s_limbsInWord && dataIdx * s_limbsInWord + part < s_limbCount; ++part)
+                    word |= static_cast<word_type>(result[dataIdx * s_limbsInWord + part]) << (part * s_bitsInLimb);
+                m_data[dataIdx] = word;
+            }
+            sanatize_trail();
+            return *this;
+        }
+
+        wide_uint& operator&=(const wide_uint& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] &= other.m_data[dataIdx];
+            return *this;
+        }
+
+        wide_uint& operator|=(const wide_uint& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] |= other.m_data[dataIdx];
+            return *this;
+        }
+
+        wide_uint& operator^=(const wide_uint& other) noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                m_data[dataIdx] ^= other.m_data[dataIdx];
+            return *this;
+        }
+
+        [[nodiscard]] wide_uint operator~() const noexcept
+        {
+            wide_uint ret;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                ret.m_data[dataIdx] = ~m_data[dataIdx];
+            ret.sanatize_trail();
+            return ret;
+        }
+
+        wide_uint& operator<<=(size_t offset) noexcept
+        {
+            const auto wordShift = offset / s_bitsInWord;
+            const auto bitShift = offset % s_bitsInWord;
+            for (size_t dataIdx = s_arrSize; dataIdx-- > 0;)
+            {
+                word_type word = 0;
+                if (dataIdx >= wordShift)
+                {
+                    word = m_data[dataIdx - wordShift] << bitShift;
+                    if (bitShift != 0 && dataIdx > wordShift)
+                        word |= m_data[dataIdx - wordShift - 1] >> (s_bitsInWord - bitShift);
+                }
+                m_data[dataIdx] = word;
+            }
+            sanatize_trail();
+            return *this;
+        }
+
+        wide_uint& operator>>=(size_t offset) noexcept
+        {
+            const auto wordShift = offset / s_bitsInWord;
+            const auto bitShift = offset % s_bitsInWord;
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+            {
+                word_type word = 0;
+                if (dataIdx + wordShift < s_arrSize)
+                {
+                    word = m_data[dataIdx + wordShift] >> bitShift;
+                    if (bitShift != 0 && dataIdx + wordShift + 1 < s_arrSize)
+                        word |= m_data[dataIdx + wordShift + 1] << (s_bitsInWord - bitShift);
+                }
+                m_data[dataIdx] = word;
+            }
+            return *this;
+        }
+
+        wide_uint& operator++() noexcept
+        {
+            return *this += wide_uint(1);
+        }
+
+        wide_uint& operator--() noexcept
+        {
+            return *this -= wide_uint(1);
+        }
+
+        [[nodiscard]] bool operator==(const wide_uint& other) const noexcept
+        {
+            for (size_t dataIdx = 0; dataIdx < s_arrSize; ++dataIdx)
+                if (m_data[dataIdx] != other.m_data[dataIdx])
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] bool operator!=(const wide_uint& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] bool operator<(const wide_uint& other) const noexcept
+        {
+            for (size_t dataIdx = s_arrSize; dataIdx-- > 0;)
+                if (m_data[dataIdx] != other.m_data[dataIdx])
+                    return m_data[dataIdx] < other.m_data[dataIdx];
+
+            return false;
+        }
+
+        [[nodiscard]] bool operator>(const wide_uint& other) const noexcept
+        {
+            return other < *this;
+        }
+
+        [[nodiscard]] bool operator<=(const wide_uint& other) const noexcept
+        {
+            return !(other < *this);
+        }
+
+        [[nodiscard]] bool operator>=(const wide_uint& other) const noexcept
+        {
+            return !(*this < other);
+        }
+
+    private:
+        limb_type limb(size_t limbIdx) const noexcept
+        {
+            return static_cast<limb_type>(m_data[limbIdx / s_limbsInWord] >> (limbIdx % s_limbsInWord * s_bitsInLimb));
+        }
+
+        // carry out of bit _bits - 1 if the last word is only partially used
+        bool finish_carry(bool carry) noexcept
+        {
+            if constexpr (_bits % s_bitsInWord != 0)
+            {
+                carry = (m_data[s_arrSize - 1] >> (_bits % s_bitsInWord)) & 1;
+                sanatize_trail();
+            }
+            return carry;
+        }
+
+        constexpr void sanatize_trail() noexcept
+        {
+            if constexpr (_bits % s_bitsInWord != 0)
+                m_data[s_arrSize - 1] &= (static_cast<word_type>(1) << _bits % s_bitsInWord) - 1;
+        }
+
+#ifdef __AVR__
+        // dst += src over all bytes of the value, returns the carry
+        static bool avr_add(uint8_t* pDst, const uint8_t* pSrc) noexcept
+        {
+            uint8_t count = sizeof(m_data);
+            uint8_t carry;
+            asm volatile(
+                "clc"                       "\n\t"
+                "1:"                        "\n\t"
+                "ld __tmp_reg__, %a[dst]"   "\n\t"
+                "ld %[carry], %a[src]+"     "\n\t"
+                "adc __tmp_reg__, %[carry]" "\n\t"
+                "st %a[dst]+, __tmp_reg__"  "\n\t"
+                "dec %[count]"              "\n\t" // dec leaves the carry flag alone
+                "brne 1b"                   "\n\t"
+                "clr %[carry]"              "\n\t" // so does eor
+                "adc %[carry], __zero_reg__" "\n\t"
+                : [dst] "+e" (pDst), [src] "+e" (pSrc), [count] "+r" (count), [carry] "=&r" (carry)
+                :
+                : "memory");
+            return carry != 0;
+        }
+
+        // dst -= src over all bytes of the value, returns the borrow
+        static bool avr_sub(uint8_t* pDst, const uint8_t* pSrc) noexcept
+        {
+            uint8_t count = sizeof(m_data);
+            uint8_t borrow;
+            asm volatile(
+                "clc"                        "\n\t"
+                "1:"                         "\n\t"
+                "ld __tmp_reg__, %a[dst]"    "\n\t"
+                "ld %[borrow], %a[src]+"     "\n\t"
+                "sbc __tmp_reg__, %[borrow]" "\n\t"
+                "st %a[dst]+, __tmp_reg__"   "\n\t"
+                "dec %[count]"               "\n\t"
+                "brne 1b"                    "\n\t"
+                "clr %[borrow]"              "\n\t"
+                "adc %[borrow], __zero_reg__" "\n\t"
+                : [dst] "+e" (pDst), [src] "+e" (pSrc), [count] "+r" (count), [borrow] "=&r" (borrow)
+                :
+                : "memory");
+            return borrow != 0;
+        }
+#endif // __AVR__
+
+        static constexpr size_t s_bitsInWord = 8 * sizeof(word_type);
+        static constexpr size_t s_arrSize = (_bits - 1) / s_bitsInWord + 1;
+        static constexpr size_t s_bitsInLimb = 8 * sizeof(limb_type);
+        static constexpr size_t s_limbsInWord = sizeof(word_type) / sizeof(limb_type);
+        static constexpr size_t s_limbCount = (_bits - 1) / s_bitsInLimb + 1;
+
+        word_type m_data[s_arrSize];
+    };
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator+(wide_uint<_bits> lhs, const wide_uint<_bits>& rhs) noexcept
+    {
+        return lhs += rhs;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator-(wide_uint<_bits> lhs, const wide_uint<_bits>& rhs) noexcept
+    {
+        return lhs -= rhs;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator*(wide_uint<_bits> lhs, const wide_uint<_bits>& rhs) noexcept
+    {
+        return lhs *= rhs;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator&(wide_uint<_bits> lhs, const wide_uint<_bits>& rhs) noexcept
+    {
+        return lhs &= rhs;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator|(wide_uint<_bits> lhs, const wide_uint<_bits>& rhs) noexcept
+    {
+        return lhs |= rhs;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator^(wide_uint<_bits> lhs, const wide_uint<_bits>& rhs) noexcept
+    {
+        return lhs ^= rhs;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator<<(wide_uint<_bits> lhs, size_t offset) noexcept
+    {
+        return lhs <<= offset;
+    }
+
+    template<size_t _bits>
+    [[nodiscard]] wide_uint<_bits> operator>>(wide_uint<_bits> lhs, size_t offset) noexcept
+    {
+        return lhs >>= offset;
+    }
+}
+#endif // ASTD_WIDE_UINT
\ No newline at end of file